@@ -56,8 +56,9 @@ void Encoder::SetOnPress(std::function<void(void)> onPress)
 
 void Encoder::Process()
 {
-    while (!directions_.empty()) {
-        if (directions_.front() == Direction::Left) {
+    Direction direction;
+    while (directions_.try_pop(direction)) {
+        if (direction == Direction::Left) {
             if (onLeft_) {
                 onLeft_();
             }
@@ -66,7 +67,6 @@ void Encoder::Process()
                 onRight_();
             }
         }
-        directions_.pop_front();
     }
     if (button_) {
         button_->Process();
@@ -114,7 +114,7 @@ ______       ______
         if ((ccwFall_) && (!pinA && !pinB)) {
             cwFall_ = 0;
             ccwFall_ = 0;
-            directions_.push_back(Direction::Right);
+            directions_.try_push(Direction::Right);
         }
     }
     if (gpio == pinB_) {
@@ -125,7 +125,7 @@ ______       ______
         if ((cwFall_) && (!pinA && !pinB)) {
             cwFall_ = 0;
             ccwFall_ = 0;
-            directions_.push_back(Direction::Left);
+            directions_.try_push(Direction::Left);
         }
     }
 }
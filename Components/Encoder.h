@@ -31,7 +31,8 @@ private:
     std::shared_ptr<Button> button_ = nullptr;
 
     bool checkingDirection_ = false;
-    CircleDeq<Direction> directions_;
+    // Filled by the GPIO interrupt, drained by Process.
+    CircleDeq<Direction, 16> directions_;
 
     std::function<void()> onLeft_ = nullptr;
     std::function<void()> onRight_ = nullptr;
@@ -1,12 +1,17 @@
 #include "PerfGraph.h"
+#include "Utils/Logger.h"
+#include "Utils/WarmState.h"
+#include "Utils/Telemetry.h"
 
 #include <hagl.h>
 #include <fonts.h>
 
 #include <cstring>
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <iomanip>
+#include <type_traits>
 
 namespace mini_lcd
 {
@@ -17,19 +22,86 @@ std::array<uint16_t, 16> colors = {Color::RED, Color::GREEN, Color::BLUE, Color:
     Color::CYAN, Color::MAGENTA, Color::ORANGE, Color::PURPLE, Color::PINK, Color::BROWN,
     Color::DARK_GRAY, Color::DARK_GRAY, Color::DARK_GRAY, Color::DARK_GRAY, Color::DARK_GRAY,
     Color::DARK_GRAY};
+
+constexpr int bezelTop = 5;
+constexpr int bezelBottom = 5;
+constexpr int16_t bezelHeight = Display::height - bezelTop - bezelBottom + 1;
+constexpr int graphHeight = 70;
+
+// Background with a frame on the top, left and right edges.
+constexpr auto bezel()
+{
+    hagl::SpriteCanvas<Display::width, bezelHeight> canvas;
+    canvas.hline(0, 0, Display::width, 1);
+    canvas.vline(0, 0, bezelHeight - 1, 1);
+    canvas.vline(Display::width - 1, 0, bezelHeight - 1, 1);
+    return canvas;
 }
 
+constexpr auto cpuCanvas = bezel();
+// Bezel plus the backgrounds of the GPU and RAM plots.
+constexpr auto miscCanvas = [] {
+    auto canvas = bezel();
+    constexpr int16_t top = Display::height - graphHeight - bezelTop;
+    canvas.fill_rectangle(2, top, Display::width / 2 - 1, bezelHeight, 2);
+    canvas.fill_rectangle(Display::width / 2 + 2, top, Display::width - 2, bezelHeight, 2);
+    return canvas;
+}();
+
+constexpr hagl_color_t bezelPalette[] = {
+    hagl_color(6, 6, 30), hagl_color(12, 163, 196), hagl_color(26, 26, 10)};
+constexpr auto cpuRuns = hagl::sprite_runs<cpuCanvas>();
+constexpr auto miscRuns = hagl::sprite_runs<miscCanvas>();
+constexpr hagl_sprite_t cpuBackground = hagl::sprite<cpuCanvas>(cpuRuns, bezelPalette);
+constexpr hagl_sprite_t miscBackground = hagl::sprite<miscCanvas>(miscRuns, bezelPalette);
+
+// Not used by any of the graphs, marks layer pixels that show the background.
+constexpr hagl_color_t colorKey = hagl_color(8, 4, 8);
+
+// Concentric rings open at the bottom, CPU outside, then GPU and RAM.
+constexpr int16_t gaugeX = Display::width / 2;
+constexpr int16_t gaugeY = 64;
+constexpr int16_t gaugeStart = 135;
+constexpr int16_t gaugeSweep = 270;
+constexpr hagl_color_t gaugeTrack = Color::DARK_GRAY;
+
+// Chart views: 16 rows of 7 px under the header line, mean load below.
+constexpr int16_t chartTop = 12;
+constexpr int16_t chartHeight = 112;
+constexpr int16_t meanTop = 128;
+constexpr int16_t meanHeight = 30;
+constexpr uint8_t chartColumn = 2;
+
+hagl_gradient_t loadGradient;
+} // namespace
+
 PerfGraph::PerfGraph()
+    : layer_(0, kLayerTop)
+    , cpuCompositor_(&cpuBackground, colorKey)
+    , miscCompositor_(&miscBackground, colorKey)
+    , cpuGauge_(gaugeX, gaugeY, 52, 60, gaugeStart, gaugeSweep, Color::GREEN, gaugeTrack)
+    , gpuGauge_(gaugeX, gaugeY, 40, 48, gaugeStart, gaugeSweep, colors[3], gaugeTrack)
+    , ramGauge_(gaugeX, gaugeY, 28, 36, gaugeStart, gaugeSweep, colors[2], gaugeTrack)
+    , cpuHeatmap_(0, chartTop, Display::width, chartHeight, chartColumn, kCpuSeries, &loadGradient,
+          Color::BLACK)
+    , cpuBand_(0, chartTop, Display::width, chartHeight, chartColumn, Color::DARK_GRAY,
+          Color::GREEN, Color::BLACK)
+    , cpuMeanChart_(0, meanTop, Display::width, meanHeight, chartColumn, Color::GREEN, Color::BLACK)
+    , cpuGroups_(kCpuSeries)
+    , log_(kSnapshotVersion, recordSize())
 {
-    for (auto& point : cpuData_) {
-        point.fill(0);
-    }
-    for (auto& point : gpuData_) {
-        point = 0;
-    }
-    for (auto& point : ramData_) {
-        point = 0;
+    static_assert(kLayerTop == bezelTop && kLayerHeight == bezelHeight);
+    // Blue when idle through green and yellow to red at full load.
+    hagl_gradient_hsl(&loadGradient, 170, 0, 255, 128);
+    for (auto& series : cpuRanks_) {
+        series.fill(0);
     }
+    [[maybe_unused]] auto size = [](auto parts) {
+        return std::accumulate(parts.begin(), parts.end(), size_t{0},
+            [](size_t total, auto part) { return total + part.size(); });
+    };
+    assert(size(snapshot()) == snapshotSize() && size(record()) == recordSize());
+    restore();
 }
 
 void PerfGraph::SetCpuDisplay(Display* display)
@@ -39,11 +111,15 @@ void PerfGraph::SetCpuDisplay(Display* display)
         if (display == miscDisplay_) {
             SetMiscDisplay(nullptr);
         }
+        if (display == gaugeDisplay_) {
+            SetGaugeDisplay(nullptr);
+        }
     }
     if (cpuDisplay_) {
         cpuDisplay_->clear();
     }
     cpuDisplay_ = display;
+    setCpuView(cpuView_);
     lastUpdate_ = 0;
     Process();
 }
@@ -55,11 +131,37 @@ void PerfGraph::SetMiscDisplay(Display* display)
         if (display == cpuDisplay_) {
             SetCpuDisplay(nullptr);
         }
+        if (display == gaugeDisplay_) {
+            SetGaugeDisplay(nullptr);
+        }
     }
     if (miscDisplay_) {
         miscDisplay_->clear();
     }
     miscDisplay_ = display;
+    miscCompositor_.invalidate();
+    lastUpdate_ = 0;
+    Process();
+}
+
+void PerfGraph::SetGaugeDisplay(Display* display)
+{
+    if (display) {
+        display->clear();
+        if (display == cpuDisplay_) {
+            SetCpuDisplay(nullptr);
+        }
+        if (display == miscDisplay_) {
+            SetMiscDisplay(nullptr);
+        }
+    }
+    if (gaugeDisplay_) {
+        gaugeDisplay_->clear();
+    }
+    gaugeDisplay_ = display;
+    cpuGauge_.invalidate();
+    gpuGauge_.invalidate();
+    ramGauge_.invalidate();
     lastUpdate_ = 0;
     Process();
 }
@@ -67,114 +169,343 @@ void PerfGraph::SetMiscDisplay(Display* display)
 void PerfGraph::AddData(Message& msg)
 {
     assert(msg.type == Message::Type::Measurements);
-    std::memcpy(cpuData_[cpuStartIndex_].data(), msg.data.data(), 16 * sizeof(uint32_t));
-    std::sort(cpuData_[cpuStartIndex_].begin(), cpuData_[cpuStartIndex_].end(),
-        [](uint32_t a, uint32_t b) { return a > b; });
+    int cores = std::min<int>(msg.data[Message::Cores], Message::kMaxCores);
+    auto t = cpuStartIndex_;
+    uint32_t seconds = this->seconds();
+
+    std::array<uint8_t, kCpuSeries> ranks;
+    cpuSummary_[t] = cpuStats_.Update(msg, ranks.data());
 
-    ramData_[miscStartIndex_] = msg.data[16];
-    gpuData_[miscStartIndex_] = msg.data[17];
-    gpuvd_ = msg.data[18];
-    gpuve_ = msg.data[19];
-    gpumem_ = msg.data[20];
+    std::array<uint8_t, kCpuSeries> groups;
+    for (int k = 0; k < kCpuSeries; ++k) {
+        cpuRanks_[k][t] = ranks[k];
+
+        // With fewer cores than groups a core fills several rows.
+        int first = k * cores / kCpuSeries;
+        int last = std::max(first + 1, (k + 1) * cores / kCpuSeries);
+        uint8_t max = 0;
+        for (int core = first; core < last && core < cores; ++core) {
+            max = std::max<uint8_t>(max, msg.CoreLoad(core));
+        }
+        groups[k] = std::min<uint8_t>(max, 100);
+    }
+    cpuGroups_.Append(seconds, groups.data());
+
+    // Free RAM in MB, the history keeps 16 bits and the charts top out at 64 GB anyway. Clamped
+    // rather than wrapped, so 64 GB or more shows as full scale instead of nothing.
+    ramHistory_.Add(seconds, std::min<uint32_t>(msg.data[Message::Ram], UINT16_MAX));
+    gpuHistory_.Add(seconds, msg.data[Message::Gpu]);
+    cpuPeak_.Add(seconds, cpuSummary_[t].mean);
+    gpuAverage_.Add(seconds, msg.data[Message::Gpu]);
 
     cpuStartIndex_ = (cpuStartIndex_ + 1) % kMaxCpuDataPoints;
-    miscStartIndex_ = (miscStartIndex_ + 1) % kMaxMiscDataPoints;
+    pendingColumns_ = std::min<uint32_t>(pendingColumns_ + 1, kMaxCpuDataPoints);
+    lastSeconds_ = seconds;
+
+    if (seconds - lastSave_ >= kSaveIntervalSeconds) {
+        Save();
+    }
+}
+
+void PerfGraph::Save()
+{
+    lastSave_ = lastSeconds_;
+    WarmState::Store(warmBlock(), kSnapshotVersion, snapshot());
+    log_.Append(record());
+}
+
+std::array<std::span<uint8_t>, 7> PerfGraph::snapshot()
+{
+    auto bytes = [](auto& member) {
+        static_assert(std::is_trivially_copyable_v<std::remove_reference_t<decltype(member)>>);
+        return std::span(reinterpret_cast<uint8_t*>(&member), sizeof(member));
+    };
+    return {bytes(cpuRanks_), bytes(cpuSummary_), bytes(cpuStartIndex_), bytes(cpuGroups_),
+        bytes(gpuHistory_), bytes(ramHistory_), bytes(lastSeconds_)};
+}
+
+std::array<std::span<uint8_t>, 4> PerfGraph::record()
+{
+    auto parts = snapshot();
+    return {parts[3], parts[4], parts[5], parts[6]};
+}
+
+std::span<uint8_t> PerfGraph::warmBlock()
+{
+    // Left alone by the start-up code, holds what the previous boot stored.
+    alignas(4) static uint8_t __uninitialized_ram(warmHistory)[WarmState::StorageSize(
+        snapshotSize())];
+    return warmHistory;
+}
+
+void PerfGraph::restore()
+{
+    // After a warm reboot the RAM copy is at least as new as the last flash record and holds the
+    // per-sample CPU series too. Both are saved only every kSaveIntervalSeconds though, so either
+    // can be minutes old before the reset itself.
+    if (WarmState::Load(warmBlock(), kSnapshotVersion, snapshot())) {
+        Logger::info() << "Warm history\n";
+    } else {
+        auto stored = log_.Latest();
+        if (stored.empty()) {
+            return;
+        }
+        for (auto part : record()) {
+            std::copy_n(stored.begin(), part.size(), part.begin());
+            stored = stored.subspan(part.size());
+        }
+        // The per-sample CPU series are not stored and start over.
+        Logger::info() << "Cold history\n";
+    }
+    // How long ago the last sample was taken is unknown, every history gets a gap marker and the
+    // clock goes on right after it.
+    std::array<uint8_t, kCpuSeries> gap;
+    gap.fill(kGapLoad);
+    cpuGroups_.Append(lastSeconds_ + 1, gap.data());
+    gpuHistory_.AddGap();
+    ramHistory_.AddGap();
+    clockOffset_ = lastSeconds_ + 2;
+    lastSave_ = lastSeconds_;
+    pendingColumns_ = kMaxCpuDataPoints;
+    Logger::info() << "Restored history up to " << lastSeconds_ << " s, marked as a gap\n";
+}
+
+uint32_t PerfGraph::seconds() const
+{
+    return millis() / 1000 + clockOffset_;
+}
+
+void PerfGraph::NextCpuView()
+{
+    setCpuView(static_cast<CpuView>(
+        (static_cast<int>(cpuView_) + 1) % static_cast<int>(CpuView::Count)));
+    lastUpdate_ = 0;
+    Process();
 }
 
-void drawGraphFrame(Display* display)
+void PerfGraph::PreviousCpuView()
 {
-    constexpr int bezelX = 0;
-    constexpr int bezelTop = 5;
-    constexpr int bezelBottom = 5;
-    display->rectangle(bezelX, bezelTop, display->width - bezelX - 1, display->height - bezelBottom,
-        hagl_color(6, 6, 30), true);
-    display->hline(bezelX, bezelTop, display->width - bezelX * 2, hagl_color(12, 163, 196));
-    display->vline(
-        bezelX, bezelTop, display->height - bezelTop - bezelBottom, hagl_color(12, 163, 196));
-    display->vline(display->width - bezelX - 1, bezelTop, display->height - bezelTop - bezelBottom,
-        hagl_color(12, 163, 196));
+    auto count = static_cast<int>(CpuView::Count);
+    setCpuView(static_cast<CpuView>((static_cast<int>(cpuView_) + count - 1) % count));
+    lastUpdate_ = 0;
+    Process();
+}
+
+void PerfGraph::setCpuView(CpuView view)
+{
+    if (cpuDisplay_ && view != cpuView_) {
+        cpuDisplay_->clear();
+    }
+    cpuView_ = view;
+    cpuCompositor_.invalidate();
+    cpuHeatmap_.reset();
+    cpuBand_.reset();
+    cpuMeanChart_.reset();
+    // Charts start over with the whole history.
+    pendingColumns_ = kMaxCpuDataPoints;
+    chartsRestart_ = true;
+}
+
+void PerfGraph::drawCpuCharts()
+{
+    auto disp = cpuDisplay_;
+    if (cpuView_ == CpuView::Heatmap && pendingColumns_ > 0) {
+        // The group history reaches further back than the other series, so a restarted heatmap
+        // fills the whole sweep.
+        size_t frames = chartsRestart_ ? cpuHeatmap_.columns() - 1 : pendingColumns_;
+        cpuGroups_.ForEachLast(frames, [this, disp](uint32_t, const uint8_t* groups) {
+            if (groups[0] == kGapLoad) {
+                cpuHeatmap_.gap(*disp);
+            } else {
+                cpuHeatmap_.append(*disp, groups);
+            }
+        });
+    }
+    chartsRestart_ = false;
+
+    for (; pendingColumns_ > 0; --pendingColumns_) {
+        auto idx = (cpuStartIndex_ + kMaxCpuDataPoints - pendingColumns_) % kMaxCpuDataPoints;
+        const auto& summary = cpuSummary_[idx];
+
+        if (cpuView_ == CpuView::Band) {
+            cpuBand_.append(*disp, summary.min, summary.median, summary.max);
+        }
+        cpuMeanChart_.append(*disp, summary.mean);
+
+        if (pendingColumns_ == 1) {
+            std::wstringstream ss;
+            ss << cpuStats_.Cores() << " CPUs, mean: " << std::setw(3)
+               << static_cast<int>(summary.mean) << " %";
+            disp->text(ss.str().c_str(), 2, 2, Fonts::font5x8, Color::GREEN);
+        }
+    }
 }
 
 void PerfGraph::drawCPU()
 {
     auto disp = cpuDisplay_;
-    drawGraphFrame(disp);
+    layer_.clear(colorKey);
 
     constexpr float stretchX = disp->width / static_cast<float>(kMaxCpuDataPoints + 1);
-    float mean = 0;
     for (uint32_t i = 0; i < kMaxCpuDataPoints - 1; ++i) {
         int idx1 = (cpuStartIndex_ + i) % kMaxCpuDataPoints;
         int idx2 = (cpuStartIndex_ + i + 1) % kMaxCpuDataPoints;
 
-        for (int gpuIdx = 15; gpuIdx >= 0; --gpuIdx) {
-            uint32_t cpu1 = cpuData_[idx1][gpuIdx] * 1.5;
-            uint32_t cpu2 = cpuData_[idx2][gpuIdx] * 1.5;
-            disp->line(
-                (i + 1) * stretchX, 155 - cpu1, (i + 2) * stretchX, 155 - cpu2, colors[gpuIdx]);
-            if (i == kMaxCpuDataPoints - 2) {
-                mean += cpuData_[idx2][gpuIdx];
+        for (int rank = kCpuSeries - 1; rank >= 0; --rank) {
+            uint32_t cpu1 = cpuRanks_[rank][idx1] * 1.5;
+            uint32_t cpu2 = cpuRanks_[rank][idx2] * 1.5;
+            hagl_draw_line(layer_, (i + 1) * stretchX, 155 - cpu1, (i + 2) * stretchX, 155 - cpu2,
+                colors[rank]);
+        }
+    }
+    auto last = (cpuStartIndex_ + kMaxCpuDataPoints - 1) % kMaxCpuDataPoints;
+    const auto& summary = cpuSummary_[last];
+    auto hottest = cpuStats_.Hottest();
+    std::wstring top = L"Top: " + std::to_wstring(summary.max) + L" %";
+    std::wstring p90 = L"P90: " + std::to_wstring(summary.p90) + L" %";
+    std::wstring median = L"Median: " + std::to_wstring(summary.median) + L" %";
+    std::wstring meanStr = L"Mean: " + std::to_wstring(summary.mean) + L" %";
+    std::wstring bottom = L"Bottom: " + std::to_wstring(summary.min) + L" %";
+    std::wstring hot = L"Hot: CPU" + std::to_wstring(hottest) + L" " +
+                       std::to_wstring(cpuStats_.Smoothed(hottest)) + L" %";
+
+    hagl_put_text(layer_, top.c_str(), 10, 10, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    hagl_put_text(layer_, p90.c_str(), 10, 20, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    hagl_put_text(layer_, median.c_str(), 10, 30, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    hagl_put_text(layer_, meanStr.c_str(), 10, 40, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    hagl_put_text(layer_, bottom.c_str(), 10, 50, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    hagl_put_text(layer_, hot.c_str(), 10, 60, Color::GREEN, Fonts::font5x8, Color::BLACK);
+    cpuCompositor_.flush(*disp, layer_);
+}
+
+void PerfGraph::NextRange()
+{
+    range_ = static_cast<Range>((static_cast<int>(range_) + 1) % static_cast<int>(Range::Count));
+    lastUpdate_ = 0;
+    Process();
+}
+
+void PerfGraph::drawHistory(const History& history, int16_t x0, uint32_t scale, hagl_color_t color)
+{
+    constexpr int16_t width = Display::width / 2 - 4;
+    constexpr int16_t bottom = 155;
+    auto level = [scale](uint32_t value) {
+        return static_cast<int16_t>(bottom - std::min(value, scale) * graphHeight / scale);
+    };
+
+    if (range_ == Range::Minute) {
+        auto size = history.Size(History::Tier::Raw);
+        if (size == 0) {
+            return;
+        }
+        // Samples are placed by age, the newest on the right edge.
+        auto now = history.Time(size - 1);
+        int16_t previousX = 0;
+        int16_t previousY = 0;
+        for (size_t i = 0; i < size; ++i) {
+            auto age = now - history.Time(i);
+            if (age > 60) {
+                continue;
             }
+            int16_t x = x0 + width - age * width / 60;
+            int16_t y = level(history.At(History::Tier::Raw, i).mean);
+            if (previousX) {
+                hagl_draw_line(layer_, previousX, previousY, x, y, color);
+            }
+            previousX = x;
+            previousY = y;
         }
+        return;
     }
-    auto& lastPoint = cpuData_[(cpuStartIndex_ + kMaxCpuDataPoints - 1) % kMaxCpuDataPoints];
-    mean /= 16.f;
-    std::wstring top = L"Top: " + std::to_wstring(lastPoint[0]) + L" %";
-    std::wstring median = L"Median: " + std::to_wstring(lastPoint[8]) + L" %";
-    std::wstring meanStr = L"Mean: " + std::to_wstring(static_cast<int>(mean)) + L" %";
-    std::wstring bottom = L"Bottom: " + std::to_wstring(lastPoint[15]) + L" %";
 
-    disp->text(top.c_str(), 10, 10, Fonts::font5x8, Color::GREEN);
-    disp->text(median.c_str(), 10, 20, Fonts::font5x8, Color::GREEN);
-    disp->text(meanStr.c_str(), 10, 30, Fonts::font5x8, Color::GREEN);
-    disp->text(bottom.c_str(), 10, 40, Fonts::font5x8, Color::GREEN);
+    auto tier = range_ == Range::Hour ? History::Tier::Minute : History::Tier::Hour;
+    int16_t slots = range_ == Range::Hour ? 60 : 24;
+    int16_t step = width / slots;
+    auto size = std::min<size_t>(history.Size(tier), slots);
+    auto first = history.Size(tier) - size;
+    int16_t previousY = 0;
+    bool connect = false;
+    for (size_t i = 0; i < size; ++i) {
+        auto bucket = history.At(tier, first + i);
+        int16_t x = x0 + width - (size - i) * step;
+        if (History::IsGap(bucket)) {
+            // Dotted marker where the board was off, the mean line breaks there.
+            for (int16_t dotY = level(scale); dotY <= bottom; dotY += 3) {
+                hagl_put_pixel(layer_, x + step / 2, dotY, Color::GRAY);
+            }
+            connect = false;
+            continue;
+        }
+        int16_t y = level(bucket.mean);
+        hagl_fill_rectangle_xyxy(
+            layer_, x, level(bucket.max), x + step - 1, level(bucket.min), Color::DARK_GRAY);
+        if (connect) {
+            hagl_draw_line(layer_, x - step, previousY, x, y, color);
+        }
+        previousY = y;
+        connect = true;
+    }
 }
 
 void PerfGraph::drawMisc()
 {
     auto disp = miscDisplay_;
-    auto lastIndex = (miscStartIndex_ + kMaxMiscDataPoints - 1) % kMaxMiscDataPoints;
-    drawGraphFrame(disp);
+    layer_.clear(colorKey);
+    int16_t y = 10;
     std::wstringstream ss;
-    ss << "RAM: " << std::fixed << std::setprecision(2) << 64.0f - ramData_[lastIndex] / 1024.0f
+    auto line = [this, &y, &ss](hagl_color_t color) {
+        hagl_put_text(layer_, ss.str().c_str(), 10, y, color, Fonts::font5x8, Color::BLACK);
+        ss.str(std::wstring());
+        y += 9;
+    };
+    // Current values straight from core0, consistent without waiting for a message.
+    auto telemetry = Telemetry::Shared().Read();
+    ss << "RAM: " << std::fixed << std::setprecision(2) << 64.0f - telemetry.ram / 1024.0f
        << " GB";
-    disp->text(ss.str().c_str(), 10, 10, Fonts::font5x8, Color::WHITE);
-    ss.str(std::wstring());
-    ss << "GPU: " << gpuData_[lastIndex] << " %";
-    disp->text(ss.str().c_str(), 10, 20, Fonts::font5x8, Color::WHITE);
-    ss.str(std::wstring());
-    ss << "GPUVD: " << gpuvd_ << " %";
-    disp->text(ss.str().c_str(), 10, 30, Fonts::font5x8, Color::WHITE);
-    ss.str(std::wstring());
-    ss << "GPUVE: " << gpuve_ << " %";
-    disp->text(ss.str().c_str(), 10, 40, Fonts::font5x8, Color::WHITE);
-    ss.str(std::wstring());
-    ss << "GPUMEM: " << std::fixed << std::setprecision(2) << gpumem_ / 1024.0 << " GB";
-    disp->text(ss.str().c_str(), 10, 50, Fonts::font5x8, Color::WHITE);
-    ss.str(std::wstring());
-
-    constexpr float stretchX = cpuDisplay_->width / 2 / static_cast<float>(kMaxMiscDataPoints + 1);
-    constexpr int graphHeight = 70;
+    line(Color::WHITE);
+    ss << "GPU: " << telemetry.gpu << " %  " << std::fixed << std::setprecision(2)
+       << telemetry.gpuMem / 1024.0 << " GB";
+    line(Color::WHITE);
+    ss << "VD: " << telemetry.gpuVd << " %  VE: " << telemetry.gpuVe << " %";
+    line(Color::WHITE);
+    ss << "RTT: " << telemetry.pollRttMs << " ms  " << telemetry.rssi << " dBm";
+    line(telemetry.pollFailures ? Color::YELLOW : Color::WHITE);
+    ss << "CPU peak 1 min: " << cpuPeak_.Max() << " %";
+    line(Color::GREEN);
+    ss << "GPU avg 5 min: " << gpuAverage_.Mean() << " %";
+    line(colors[3]);
+    ss << "GPU >90 %: " << static_cast<int>(gpuAverage_.AbovePercent()) << " % of 5 min";
+    line(colors[3]);
+    constexpr const wchar_t* rangeNames[] = {L"Last minute", L"Last hour", L"Last day"};
+    hagl_put_text(layer_, rangeNames[static_cast<int>(range_)], 10, y + 2, Color::GRAY,
+        Fonts::font5x8, Color::BLACK);
 
-    disp->rectangle(2, disp->height - graphHeight, disp->width / 2 - 1, disp->height,
-        hagl_color(26, 26, 10), true);
-
-    disp->rectangle(disp->width / 2 + 2, disp->height - graphHeight, disp->width - 2, disp->height,
-        hagl_color(26, 26, 10), true);
-
-    for (uint32_t i = 0; i < kMaxMiscDataPoints - 1; ++i) {
-        int idx1 = (miscStartIndex_ + i) % kMaxMiscDataPoints;
-        int idx2 = (miscStartIndex_ + i + 1) % kMaxMiscDataPoints;
+    drawHistory(gpuHistory_, 2, 100, colors[3]);
+    drawHistory(ramHistory_, disp->width / 2 + 2, 64 * 1024, colors[2]);
+    miscCompositor_.flush(*disp, layer_);
+}
 
-        uint32_t gpu1 = gpuData_[idx1] * static_cast<float>(graphHeight) / 100.0f;
-        uint32_t gpu2 = gpuData_[idx2] * static_cast<float>(graphHeight) / 100.0f;
-        disp->line((i + 1) * stretchX, 155 - gpu1, (i + 2) * stretchX, 155 - gpu2, colors[3]);
+void PerfGraph::drawGauges()
+{
+    auto disp = gaugeDisplay_;
+    uint32_t cpu = cpuSummary_[(cpuStartIndex_ + kMaxCpuDataPoints - 1) % kMaxCpuDataPoints].mean;
+    uint32_t gpu = gpuHistory_.Last();
+    uint32_t ram = 100 - std::min<uint32_t>(ramHistory_.Last() * 100 / (64 * 1024), 100);
 
-        uint32_t ram1 = ramData_[idx1] / 1024.0f / 64.0f * static_cast<float>(graphHeight);
-        uint32_t ram2 = ramData_[idx2] / 1024.0f / 64.0f * static_cast<float>(graphHeight);
+    // Only the wedge between the previous and the current value is redrawn.
+    cpuGauge_.draw(*disp, cpu);
+    gpuGauge_.draw(*disp, gpu);
+    ramGauge_.draw(*disp, ram);
 
-        disp->line((i + 1) * stretchX + disp->width / 2, 155 - ram1,
-            (i + 2) * stretchX + disp->width / 2, 155 - ram2, colors[2]);
-    }
+    std::wstringstream ss;
+    ss << "CPU: " << std::setw(3) << cpu << " %";
+    disp->text(ss.str().c_str(), 40, 120, Fonts::font5x8, Color::GREEN);
+    ss.str(std::wstring());
+    ss << "GPU: " << std::setw(3) << gpu << " %";
+    disp->text(ss.str().c_str(), 40, 132, Fonts::font5x8, colors[3]);
+    ss.str(std::wstring());
+    ss << "RAM: " << std::setw(3) << ram << " %";
+    disp->text(ss.str().c_str(), 40, 144, Fonts::font5x8, colors[2]);
 }
 
 void PerfGraph::Process()
@@ -185,10 +516,17 @@ void PerfGraph::Process()
     }
     lastUpdate_ = now;
     if (cpuDisplay_) {
-        drawCPU();
+        if (cpuView_ == CpuView::Lines) {
+            drawCPU();
+        } else {
+            drawCpuCharts();
+        }
     }
     if (miscDisplay_) {
         drawMisc();
     }
+    if (gaugeDisplay_) {
+        drawGauges();
+    }
 }
 } // namespace mini_lcd
@@ -1,37 +1,125 @@
 #pragma once
 #include "Display.h"
+#include "Layer.h"
+#include "Compositor.h"
+#include "Gauge.h"
+#include "Chart.h"
 #include "Utils/Comm.h"
+#include "Utils/TimeSeries.h"
+#include "Utils/HistoryBlock.h"
+#include "Utils/CpuStats.h"
+#include "Utils/SlidingWindow.h"
+#include "Utils/FlashLog.h"
 #include "ino_compat.h"
 
+#include <span>
+
 namespace mini_lcd
 {
 class PerfGraph
 {
 public:
+    enum class CpuView : uint8_t { Lines, Heatmap, Band, Count };
+    // Time span of the GPU and RAM plots.
+    enum class Range : uint8_t { Minute, Hour, Day, Count };
+
     PerfGraph();
     void SetCpuDisplay(Display* display);
     void SetMiscDisplay(Display* display);
+    void SetGaugeDisplay(Display* display);
     void AddData(Message& msg);
+    void NextCpuView();
+    void PreviousCpuView();
+    void NextRange();
+    // Persists the history to flash and to RAM kept across a warm reboot, so that the graphs come
+    // back populated. Called every few minutes and right before a deliberate reboot.
+    void Save();
 
     void Process();
 
 private:
+    // Bump when the layout of the persisted members changes.
+    static constexpr uint32_t kSnapshotVersion = 2;
+    static constexpr uint32_t kSaveIntervalSeconds = 10 * 60;
+
+    // Raw samples cover a minute at one sample per second, the tiers an hour and a day.
+    using History = TimeSeries<64, 60, 24>;
+
+    // Group load of a frame that marks a stretch without samples, real loads are at most 100.
+    static constexpr uint8_t kGapLoad = UINT8_MAX;
+
+    // Members kept across a warm reboot.
+    std::array<std::span<uint8_t>, 7> snapshot();
+    // Sum of the members in snapshot(), keep the two in line.
+    static constexpr size_t snapshotSize()
+    {
+        return sizeof(cpuRanks_) + sizeof(cpuSummary_) + sizeof(cpuStartIndex_) +
+            sizeof(cpuGroups_) + sizeof(gpuHistory_) + sizeof(ramHistory_) + sizeof(lastSeconds_);
+    }
+    // Members written to flash, the timestamped histories that a cold start can still show.
+    std::array<std::span<uint8_t>, 4> record();
+    static constexpr size_t recordSize()
+    {
+        return sizeof(cpuGroups_) + sizeof(gpuHistory_) + sizeof(ramHistory_) +
+            sizeof(lastSeconds_);
+    }
+    // Warm state block sized for one snapshot.
+    static std::span<uint8_t> warmBlock();
+    void restore();
+    // Sample time in seconds, continuing from the restored history.
+    uint32_t seconds() const;
+    void setCpuView(CpuView view);
     void drawCPU();
+    void drawCpuCharts();
     void drawMisc();
+    // Raw samples of the last minute, or min/max bars with the mean for longer ranges.
+    void drawHistory(const History& history, int16_t x0, uint32_t scale, hagl_color_t color);
+    void drawGauges();
 
     Display* cpuDisplay_ = nullptr;
     Display* miscDisplay_ = nullptr;
+    Display* gaugeDisplay_ = nullptr;
+
+    // Dynamic content between the bezel top and bottom, drawn with the inlined Bitmap operations.
+    static constexpr int16_t kLayerTop = 5;
+    static constexpr uint16_t kLayerHeight = Display::height - 2 * kLayerTop + 1;
+    Layer<Display::width, kLayerHeight> layer_;
+    Compositor cpuCompositor_;
+    Compositor miscCompositor_;
+    Gauge cpuGauge_;
+    Gauge gpuGauge_;
+    Gauge ramGauge_;
+    Heatmap cpuHeatmap_;
+    Band cpuBand_;
+    Sparkline cpuMeanChart_;
+    CpuView cpuView_ = CpuView::Lines;
 
     static constexpr int kMaxCpuDataPoints = 50;
-    static constexpr int kMaxMiscDataPoints = 35;
-    std::array<std::array<uint32_t, 17>, kMaxCpuDataPoints> cpuData_;
-    std::array<uint32_t, kMaxMiscDataPoints> gpuData_;
-    std::array<uint32_t, kMaxMiscDataPoints> ramData_;
+    static constexpr int kCpuSeries = CpuStats::kRanks;
+    // CPU history as a structure of arrays indexed by sample. Cores are folded into kCpuSeries
+    // values when a sample arrives, so memory and drawing cost do not depend on the core count.
+    // Load quantiles, highest first.
+    std::array<std::array<uint8_t, kMaxCpuDataPoints>, kCpuSeries> cpuRanks_;
+    // Highest load in each group of adjacent cores, one group per heatmap row. Compressed, so
+    // 8 KB keeps roughly 600 to 1000 samples of real load, an hour or more at the 5 s poll.
+    CompressedHistory<8> cpuGroups_;
+    std::array<CpuStats::Summary, kMaxCpuDataPoints> cpuSummary_{};
+    CpuStats cpuStats_;
+    History gpuHistory_;
+    History ramHistory_;
+    // Misc screen readouts, sized for about one sample per second.
+    SlidingWindow<64, WindowMax> cpuPeak_{60};
+    SlidingWindow<320, WindowMean | WindowAbove> gpuAverage_{300, 90};
+    Range range_ = Range::Minute;
     uint32_t cpuStartIndex_ = 0;
-    uint32_t miscStartIndex_ = 0;
+    // Samples not drawn by the chart views yet.
+    uint32_t pendingColumns_ = 0;
+    // Set when the charts start over, the heatmap then replays a full sweep.
+    bool chartsRestart_ = false;
     Timestamp lastUpdate_ = 0;
-    uint32_t gpuvd_ = 0;
-    uint32_t gpuve_ = 0;
-    uint32_t gpumem_ = 0;
+    uint32_t lastSeconds_ = 0;
+    uint32_t clockOffset_ = 0;
+    uint32_t lastSave_ = 0;
+    FlashLog log_;
 };
 } // namespace mini_lcd
@@ -9,6 +9,30 @@
 
 namespace mini_lcd
 {
+namespace
+{
+// Pixel exact copies of the rounded rectangles the cells used to be drawn with. The corners are
+// painted black instead of being left alone, which is what the empty cells under them hold. Next
+// to a wall the cell is clipped, so the corners never reach the wall.
+constexpr auto appleCanvas = [] {
+    hagl::SpriteCanvas<11, 11> canvas;
+    canvas.fill_rounded_rectangle(0, 0, 10, 10, 4, 1);
+    return canvas;
+}();
+constexpr auto segmentCanvas = [] {
+    hagl::SpriteCanvas<7, 7> canvas;
+    canvas.fill_rounded_rectangle(0, 0, 6, 6, 3, 1);
+    return canvas;
+}();
+
+constexpr hagl_color_t applePalette[] = {Color::BLACK, Color::GREEN};
+constexpr hagl_color_t segmentPalette[] = {Color::BLACK, Color::RED};
+constexpr auto appleRuns = hagl::sprite_runs<appleCanvas>();
+constexpr auto segmentRuns = hagl::sprite_runs<segmentCanvas>();
+constexpr hagl_sprite_t appleSprite = hagl::sprite<appleCanvas>(appleRuns, applePalette);
+constexpr hagl_sprite_t segmentSprite = hagl::sprite<segmentCanvas>(segmentRuns, segmentPalette);
+} // namespace
+
 Snake::Snake()
     : width_(Display::width / 10)
     , height_(Display::height / 10)
@@ -151,8 +175,9 @@ void Snake::spawnApple()
         }
         trySpawn();
     }
-    display_->rounded_rectangle(apple_.x * blockWidth_, apple_.y * blockHeight_,
-        (apple_.x + 1) * blockWidth_, (apple_.y + 1) * blockHeight_, 4, Color::GREEN, true);
+    auto clip = clipToField();
+    hagl_blit_sprite(*display_, apple_.x * blockWidth_, apple_.y * blockHeight_, &appleSprite);
+    display_->clip = clip;
 }
 
 void Snake::erase(Segment segment)
@@ -160,8 +185,10 @@ void Snake::erase(Segment segment)
     if (!display_) {
         return;
     }
+    auto clip = clipToField();
     display_->rectangle(segment.x * blockWidth_, segment.y * blockHeight_,
         (segment.x + 1) * blockWidth_, (segment.y + 1) * blockHeight_, Color::BLACK, true);
+    display_->clip = clip;
 }
 
 void Snake::draw(Segment segment)
@@ -169,8 +196,18 @@ void Snake::draw(Segment segment)
     if (!display_) {
         return;
     }
-    display_->rounded_rectangle(segment.x * blockWidth_ + 2, segment.y * blockHeight_ + 2,
-        (segment.x + 1) * blockWidth_ - 2, (segment.y + 1) * blockHeight_ - 2, 3, Color::RED, true);
+    auto clip = clipToField();
+    hagl_blit_sprite(
+        *display_, segment.x * blockWidth_ + 2, segment.y * blockHeight_ + 2, &segmentSprite);
+    display_->clip = clip;
+}
+
+hagl_window_t Snake::clipToField()
+{
+    hagl_window_t clip = display_->clip;
+    hagl_set_clip(*display_, blockWidth_ + 1, blockHeight_ + 1, width_ * blockWidth_ - 1,
+        (height_ - 1) * blockHeight_ - 1);
+    return clip;
 }
 
 void Snake::reset()
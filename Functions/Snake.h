@@ -28,6 +28,9 @@ private:
     Segment performStep(Segment segment, Direction direction);
     void erase(Segment segment);
     void draw(Segment segment);
+    // Cells next to the walls overlap them by a pixel, so cells are drawn clipped to the inside
+    // of the walls. Returns the previous clip window to put back, other screens share the display.
+    hagl_window_t clipToField();
     void reset();
     void spawnApple();
 
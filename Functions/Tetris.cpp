@@ -1,5 +1,6 @@
 #include "Tetris.h"
 #include "fonts.h"
+#include "Utils/Logger.h"
 
 #include <array>
 #include <map>
@@ -65,6 +66,42 @@ void Tetris::SetDisplay(Display* display)
         display_->clear();
     }
     display_ = display;
+    // A game restored or started on another display continues here.
+    if (display_ && !gameOver_) {
+        display_->clear();
+        drawOccupied();
+        drawPiece(tetraminoColors.at(currentPiece_));
+    }
+}
+
+Tetris::State Tetris::GetState() const
+{
+    static_assert(std::tuple_size_v<decltype(State::rows)> == height_ && width_ <= 16);
+    State state{currentPiece_, static_cast<int8_t>(x_), static_cast<int8_t>(y_),
+        static_cast<uint8_t>(rotation_), gameOver_, {}};
+    for (const auto& occupied : occupied_) {
+        state.rows[occupied.second] |= 1 << occupied.first;
+    }
+    return state;
+}
+
+void Tetris::SetState(const State& state)
+{
+    currentPiece_ = state.piece;
+    x_ = state.x;
+    y_ = state.y;
+    rotation_ = state.rotation;
+    gameOver_ = state.gameOver;
+    occupied_.clear();
+    presentBlocks_.fill(0);
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            if (state.rows[y] & (1 << x)) {
+                occupied_.emplace_back(x, y);
+                presentBlocks_[y]++;
+            }
+        }
+    }
 }
 
 void Tetris::Left()
@@ -150,16 +187,22 @@ void Tetris::Drop()
 
 void Tetris::reset()
 {
+    const auto& stats = shapes_.stats();
+    Logger::debug() << "Shape cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                    << stats.evictions << " evictions, " << stats.bypassed << " bypassed, "
+                    << ShapeCache::kBudget << " bytes\n";
     display_->clear();
     presentBlocks_.fill(0);
     occupied_.clear();
     spawnPiece();
 }
 
+// The cached square is opaque, its rounded corners are painted black. Nothing else is drawn
+// inside a cell, so this matches the board the direct draw left them on.
 void Tetris::drawSquare(int x, int y, hagl_color_t color)
 {
-    display_->rounded_rectangle(x * blockSize_ + 1, y * blockSize_ + 1, (x + 1) * blockSize_ - 2,
-        (y + 1) * blockSize_ - 2, 11, color, true);
+    shapes_.rounded_rectangle(*display_, x * blockSize_ + 1, y * blockSize_ + 1,
+        (x + 1) * blockSize_ - 2, (y + 1) * blockSize_ - 2, 11, color, Color::BLACK);
 }
 
 void Tetris::drawPiece(hagl_color_t color)
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "Display.h"
+#include "ShapeCache.h"
 
 #include "ino_compat.h"
 
+#include <array>
 #include <list>
 
 namespace mini_lcd
@@ -12,7 +14,20 @@ class Tetris
 {
 public:
     enum class Tetramino { I, J, L, O, S, T, Z };
+    // Game in progress, kept across warm reboots. One bit per occupied cell, a word per row.
+    struct State
+    {
+        Tetramino piece;
+        int8_t x;
+        int8_t y;
+        uint8_t rotation;
+        bool gameOver;
+        std::array<uint16_t, Display::height / 10> rows;
+    };
+
     void SetDisplay(Display* display);
+    State GetState() const;
+    void SetState(const State& state);
     void Process();
     void Left();
     void Right();
@@ -40,6 +55,7 @@ private:
     static constexpr int height_ = Display::height / blockSize_;
     std::array<int, height_> presentBlocks_;
     Display* display_ = nullptr;
+    ShapeCache shapes_;
     Timestamp last_time_ = 0;
     Timestamp speed_ = 500;
     bool gameOver_ = true;
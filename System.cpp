@@ -1,11 +1,14 @@
 #include "System.h"
 #include "Utils/Logger.h"
+#include "Utils/WarmState.h"
 #include "fonts.h"
 
 #include <hardware/watchdog.h>
+#include <pico/platform.h>
 
 #include <vector>
 #include <string>
+#include <span>
 
 namespace
 {
@@ -29,9 +32,24 @@ void colorTest(Display& display)
     }
 }
 
+// Bump when the layout of the warm state changes.
+constexpr uint32_t kWarmStateVersion = 1;
+
+template <typename... T>
+auto bytes(T&... objects)
+{
+    return std::array{std::span(reinterpret_cast<uint8_t*>(&objects), sizeof(objects))...};
+}
+
+// Display functions, logger verbosity and the Tetris game, left alone by the start-up code.
+alignas(4) uint8_t __uninitialized_ram(warmState)[mini_lcd::WarmState::StorageSize(
+    sizeof(std::array<mini_lcd::Function, 4>) + sizeof(mini_lcd::Logger::Verbosity) +
+    sizeof(mini_lcd::Tetris::State))];
+
 std::vector<std::wstring> MainMenuItems = {
     L"Display functions",
     L"Logger verbosity",
+    L"Network",
     L"Reboot",
     L"Cancel",
 };
@@ -48,11 +66,22 @@ std::vector<std::wstring> FunctionNames = {
     L"Color Test",
     L"CPU Graph",
     L"Misc Graph",
+    L"Gauges",
     L"Snake",
     L"Tetris",
     L"Settings",
 };
 
+// Poll intervals first, in the order of PollIntervals.
+std::vector<std::wstring> NetworkItems = {
+    L"Poll every 1 s",
+    L"Poll every 2 s",
+    L"Poll every 5 s",
+    L"Poll every 10 s",
+    L"Reconnect Wi-Fi",
+};
+constexpr uint32_t PollIntervals[] = {1000, 2000, 5000, 10000};
+
 std::vector<std::wstring> LoggerVerbosityNames = {
     L"Trace",
     L"Debug",
@@ -76,8 +105,9 @@ System::System()
     Encoder(20, 21, 22),
 }
 {
-    encoders_[0].SetOnLeft([]() { Logger::debug() << "Encoder 0: Left\n"; });
-    encoders_[0].SetOnRight([]() { Logger::debug() << "Encoder 0: Right\n"; });
+    encoders_[0].SetOnLeft([this]() { perfGraph_.PreviousCpuView(); });
+    encoders_[0].SetOnRight([this]() { perfGraph_.NextCpuView(); });
+    encoders_[0].SetOnPress([this]() { perfGraph_.NextRange(); });
     encoders_[1].SetOnLeft([this]() { menu_.Up(); });
     encoders_[1].SetOnRight([this]() { menu_.Down(); });
     encoders_[1].SetOnPress([this]() {
@@ -108,10 +138,19 @@ System::System()
 void System::Init(std::array<Display*, 4> displays)
 {
     displays_ = displays;
-    setDisplayFunction(0, Function::MiscGraph);
-    setDisplayFunction(1, Function::CPUGraph);
-    setDisplayFunction(2, Function::Tetris);
-    setDisplayFunction(3, Function::ColorTest);
+    std::array<Function, 4> functions = {
+        Function::MiscGraph, Function::CPUGraph, Function::Tetris, Function::ColorTest};
+    Logger::Verbosity verbosity;
+    Tetris::State tetris;
+    if (WarmState::Load(warmState, kWarmStateVersion,
+            bytes(functions, verbosity, tetris))) {
+        Logger::info() << "Warm start\n";
+        Logger::GetLogger().SetVerbosity(verbosity);
+        tetris_.SetState(tetris);
+    }
+    for (int i = 0; i < 4; ++i) {
+        setDisplayFunction(i, functions[i]);
+    }
 }
 
 void System::Process()
@@ -124,6 +163,25 @@ void System::Process()
     }
     snake_.Process();
     tetris_.Process();
+    rpc_.Poll();
+
+    auto now = millis();
+    if (now - lastWarmStore_ >= 1000) {
+        lastWarmStore_ = now;
+        storeWarmState();
+    }
+}
+
+void System::storeWarmState()
+{
+    auto functions = displayFunctions;
+    // The menu is open when rebooting from it, the display gets its previous function back.
+    if (settingsDisplay_ != -1) {
+        functions[settingsDisplay_] = lastSettingFunction_;
+    }
+    auto verbosity = Logger::GetLogger().GetVerbosity();
+    auto tetris = tetris_.GetState();
+    WarmState::Store(warmState, kWarmStateVersion, bytes(functions, verbosity, tetris));
 }
 
 void System::OnMessage(Message& msg)
@@ -131,6 +189,8 @@ void System::OnMessage(Message& msg)
     if (msg.type == Message::Type::Measurements) {
         perfGraph_.AddData(msg);
         perfGraph_.Process();
+    } else if (msg.type == Message::Type::Response) {
+        rpc_.OnResponse(msg);
     } else {
         Logger::error() << "Unknown message type: " << static_cast<int>(msg.type) << "\n";
     }
@@ -174,6 +234,9 @@ void System::setDisplayFunction(int idx, Function function)
         case Function::MiscGraph:
             perfGraph_.SetMiscDisplay(nullptr);
             break;
+        case Function::Gauges:
+            perfGraph_.SetGaugeDisplay(nullptr);
+            break;
         case Function::Snake:
             snake_.SetDisplay(nullptr);
             break;
@@ -201,6 +264,9 @@ void System::setDisplayFunction(int idx, Function function)
         case Function::MiscGraph:
             perfGraph_.SetMiscDisplay(display);
             break;
+        case Function::Gauges:
+            perfGraph_.SetGaugeDisplay(display);
+            break;
         case Function::Snake:
             snake_.SetDisplay(display);
             break;
@@ -237,6 +303,11 @@ void System::onMainMenuItem(int idx)
             showVerbosityNames();
             break;
         case 2:
+            showNetworkItems();
+            break;
+        case 3:
+            storeWarmState();
+            perfGraph_.Save();
             watchdog_reboot(0, 0, 0);
             break;
         default:
@@ -284,6 +355,36 @@ void System::showVerbosityNames()
     menu_.SetItems(&LoggerVerbosityNames);
 }
 
+void System::showNetworkItems()
+{
+    menu_.SetOnSelect([this](int idx) {
+        if (idx < 0 || idx >= static_cast<int>(NetworkItems.size())) {
+            Logger::error() << "Invalid network item: " << idx << "\n";
+            return;
+        }
+        Message request;
+        auto timeoutMs = RpcClient::kDefaultTimeoutMs;
+        if (idx < static_cast<int>(std::size(PollIntervals))) {
+            request.type = Message::Type::SetPollInterval;
+            request.data[Message::Argument] = PollIntervals[idx];
+        } else {
+            request.type = Message::Type::Reconnect;
+            // Core0 gives up joining after 30 s.
+            timeoutMs = 35000;
+        }
+        // Core0 answers once it has acted, the menu does not wait for it.
+        rpc_.Call(
+            request,
+            [type = request.type](RpcStatus status) {
+                Logger::info() << "Network request " << static_cast<int>(type)
+                               << " done, status " << static_cast<int>(status) << "\n";
+            },
+            timeoutMs);
+        closeSettings();
+    });
+    menu_.SetItems(&NetworkItems);
+}
+
 void System::closeSettings()
 {
     setDisplayFunction(settingsDisplay_, lastSettingFunction_);
@@ -7,6 +7,7 @@
 #include "Functions/Menu.h"
 #include "Components/Button.h"
 #include "Components/Encoder.h"
+#include "Utils/Rpc.h"
 
 #include <array>
 #include <list>
@@ -18,11 +19,13 @@ enum class Function {
     ColorTest,
     CPUGraph,
     MiscGraph,
+    Gauges,
     Snake,
     Tetris,
     Settings,
 };
 
+// Holds all the history and drawing buffers, tens of KB, so it never goes on a stack.
 class System
 {
 public:
@@ -37,8 +40,11 @@ private:
     void showDisplayNames();
     void showFunctionNames();
     void showVerbosityNames();
+    void showNetworkItems();
     void onMainMenuItem(int idx);
     void closeSettings();
+    // Display functions, logger verbosity and the Tetris game for the next warm boot.
+    void storeWarmState();
 
     std::array<Function, 4> displayFunctions = {
         Function::None, Function::None, Function::None, Function::None};
@@ -47,11 +53,13 @@ private:
     Snake snake_;
     Tetris tetris_;
     Menu menu_;
+    RpcClient rpc_;
 
     std::array<Button, 4> buttons_;
     std::array<Encoder, 2> encoders_;
     int settingsDisplay_ = -1;
     Function lastSettingFunction_ = Function::None;
     int selectedDisplay_ = -1;
+    Timestamp lastWarmStore_ = 0;
 };
 } // namespace mini_lcd
@@ -1,6 +0,0 @@
-#include "CircleDeq.h"
-
-namespace mini_lcd
-{
-
-}
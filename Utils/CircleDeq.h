@@ -1,44 +1,75 @@
 #pragma once
-#include <array>
+
+#include "SpscRing.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
 
 namespace mini_lcd
 {
-template <typename T>
+// Queue of values between one producer and one consumer, for example an interrupt handler and the
+// main loop, or the two cores. The slots and the lock-free index protocol are those of SpscRing,
+// this adds copying values in and out. A push into a full queue is dropped and counted.
+template <typename T, size_t N>
 class CircleDeq
 {
 public:
-    void push_back(T value)
+    // Producer side.
+    bool try_push(const T& value)
     {
-        data_[end_] = value;
-        end_ = (end_ + 1) % kSize;
-        if (end_ == start_) {
-            start_ = (start_ + 1) % kSize; // Overwrite the oldest element
-        }
+        return push_bulk({&value, 1}) == 1;
     }
-    T pop_front()
+
+    // Pushes as many values as fit and returns their count, the rest is counted as overflow.
+    size_t push_bulk(std::span<const T> values)
     {
-        if (start_ == end_) {
-            return T{};
-        }
-        T value = data_[start_];
-        start_ = (start_ + 1) % kSize;
-        return value;
+        size_t count = ring_.Write(values);
+        countOverflows(values.size() - count);
+        return count;
     }
-    T front() const
+
+    // Consumer side.
+    bool try_pop(T& value)
     {
-        if (start_ == end_) {
-            return T{};
-        }
-        return data_[start_];
+        return ring_.Read({&value, 1}) == 1;
+    }
+
+    // Pops up to values.size() values and returns their count.
+    size_t pop_bulk(std::span<T> values)
+    {
+        return ring_.Read(values);
+    }
+
+    // Either side, exact only from the consumer with the producer idle and vice versa.
+    size_t size() const
+    {
+        return ring_.Size();
     }
+
     bool empty() const
     {
-        return start_ == end_;
+        return size() == 0;
+    }
+
+    // Values dropped because the queue was full.
+    uint32_t overflows() const
+    {
+        return overflows_.load(std::memory_order_relaxed);
     }
+
 private:
-    static constexpr int kSize = 128;
-    std::array<T, kSize> data_;
-    int start_ = 0;
-    int end_ = 0;
+    // Only the producer writes the counter, a read-modify-write is not available on every core.
+    void countOverflows(size_t count)
+    {
+        if (count) {
+            overflows_.store(
+                overflows_.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+    }
+
+    SpscRing<T, N> ring_;
+    std::atomic<uint32_t> overflows_ = 0;
 };
 } // namespace mini_lcd
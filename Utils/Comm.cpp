@@ -1,68 +1,153 @@
 #include "Comm.h"
+#include "SpscRing.h"
 
 #include <pico/stdlib.h>
 #include <pico/multicore.h>
 
-#include <iostream>
-#include <cstring>
-
 namespace mini_lcd
 {
-const std::map<Message::Type, int> Message::Size = {
-    {Message::Type::Measurements, 21}, {Message::Type::Snake, 1}};
+namespace
+{
+constexpr uint32_t kDoorbell = 1;
+
+// Shared by both cores, core0 produces and core1 consumes.
+SpscRing<Message, 4> ring;
+} // namespace
+
+uint8_t Message::CoreLoad(int core) const
+{
+    return data[CoreLoads + core / 4] >> (core % 4 * 8);
+}
+
+void Message::SetCoreLoad(int core, uint8_t load)
+{
+    auto& word = data[CoreLoads + core / 4];
+    auto shift = core % 4 * 8;
+    word = (word & ~(0xFFu << shift)) | (static_cast<uint32_t>(load) << shift);
+}
+
+void Message::CopyTo(Message& other) const
+{
+    other.type = type;
+    std::copy_n(data.begin(), Length(), other.data.begin());
+}
 
 Message* Receiver::Process()
 {
-    if (!multicore_fifo_rvalid()) {
-        return nullptr;
+    // The FIFO only carries doorbells that wake this core, the messages are in the ring. The ring
+    // is checked anyway, the multicore lockout handshake of a flash write may eat a doorbell.
+    while (multicore_fifo_rvalid()) {
+        multicore_fifo_pop_blocking();
     }
-    switch (state_) {
-        case State::Idle: {
-            uint32_t val = multicore_fifo_pop_blocking();
-            Message::Type type = static_cast<Message::Type>(val);
-            //std::cout << "Now receiving " << val << "\n";
-            message_.type = type;
-            if (Message::Size.count(type) == 0) {
-                std::cout << "Bad message type: " << val << "\n";
-                return nullptr;
-            }
-            toReceive_ = Message::Size.at(type);
-            if (toReceive_ == 0) {
-                return &message_;
+    if (current_) {
+        ring.Pop();
+    }
+    current_ = ring.Front();
+    return current_;
+}
+
+Message* Sender::Reserve()
+{
+    // Queued messages go first to keep the order.
+    return size_ ? nullptr : ring.Reserve();
+}
+
+void Sender::Publish()
+{
+    ring.Publish();
+    ++stats_.delivered;
+    // A full FIFO means that core1 has doorbells pending already.
+    if (multicore_fifo_wready()) {
+        multicore_fifo_push_blocking(kDoorbell);
+    }
+}
+
+Sender::Result Sender::TrySend(const Message& message)
+{
+    if (auto slot = Reserve()) {
+        message.CopyTo(*slot);
+        Publish();
+        return Result::Delivered;
+    }
+
+    if (policy(message.type) == Policy::Coalesce) {
+        for (size_t i = 0; i < size_; ++i) {
+            if (queued(i).type == message.type) {
+                message.CopyTo(queued(i));
+                ++stats_.coalesced;
+                return Result::Coalesced;
             }
-            state_ = State::Receiving;
-            return nullptr;
         }
-        case State::Receiving: {
-            message_.data[received_++] = multicore_fifo_pop_blocking();
-            //std::cout << "Received " << received_ << " out of " << toReceive_ << "\n";
-            if (received_ >= toReceive_) {
-                //std::cout << "Final\n";
-                state_ = State::Idle;
-                received_ = 0;
-                return &message_;
+    }
+    auto result = Result::Queued;
+    if (size_ == kQueueSize) {
+        if (!dropOldest()) {
+            if (policy(message.type) != Policy::Keep) {
+                ++stats_.drops;
             }
-            break;
+            return Result::Rejected;
         }
+        result = Result::DroppedOldest;
     }
-    return nullptr;
+    message.CopyTo(queued(size_++));
+    return result;
 }
 
-void Sender::Send(const Message& message)
+void Sender::Process()
 {
-    messages_.push_back(message);
+    while (size_) {
+        auto slot = ring.Reserve();
+        if (!slot) {
+            return;
+        }
+        queued(0).CopyTo(*slot);
+        start_ = (start_ + 1) % kQueueSize;
+        --size_;
+        Publish();
+    }
 }
 
-void Sender::Process()
+Sender::Stats Sender::GetStats() const
 {
-    if (messages_.empty()) {
-        return;
+    auto stats = stats_;
+    stats.depth = size_;
+    return stats;
+}
+
+Sender::Policy Sender::policy(Message::Type type)
+{
+    switch (type) {
+        case Message::Type::Measurements:
+            // Only the newest measurements are worth drawing.
+            return Policy::Coalesce;
+        case Message::Type::Response:
+            return Policy::Keep;
+        default:
+            return Policy::DropOldest;
+    }
+}
+
+Message& Sender::queued(size_t index)
+{
+    return queue_[(start_ + index) % kQueueSize];
+}
+
+bool Sender::dropOldest()
+{
+    size_t index = 0;
+    while (index < size_ && policy(queued(index).type) == Policy::Keep) {
+        ++index;
+    }
+    if (index == size_) {
+        return false;
     }
-    auto& message = messages_.front();
-    multicore_fifo_push_blocking(static_cast<uint32_t>(message.type));
-    for (int i = 0; i < Message::Size.at(message.type); ++i) {
-        multicore_fifo_push_blocking(message.data[i]);
+    // The messages in front of it move up one place, the order stays.
+    for (; index > 0; --index) {
+        queued(index - 1).CopyTo(queued(index));
     }
-    messages_.pop_front();
+    start_ = (start_ + 1) % kQueueSize;
+    --size_;
+    ++stats_.drops;
+    return true;
 }
 } // namespace mini_lcd
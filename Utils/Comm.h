@@ -1,50 +1,131 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <array>
 #include <optional>
-#include <list>
 
 namespace mini_lcd
 {
 
 struct Message
 {
-    enum class Type : uint32_t { Unknown, Measurements, Snake };
+    // Core0 to core1: Measurements, Snake and Response. Core1 to core0: the requests.
+    enum class Type : uint32_t {
+        Unknown,
+        Measurements,
+        Snake,
+        SetPollInterval,
+        Reconnect,
+        Response,
+        Count
+    };
+
+    // Layout of Measurements: the fixed fields, then one load byte per core packed four to a
+    // word, so the length depends on the core count.
+    enum Field : int { Cores, Ram, Gpu, GpuVd, GpuVe, GpuMem, CoreLoads };
+    // Layout of requests and their responses, the argument is the status in a response.
+    enum RpcField : int { RequestId, Argument };
+    static constexpr int kMaxCores = 256;
+
+    // Fixed words of a type, optionally followed by a payload of packed bytes whose count is
+    // held in a field.
+    struct Schema
+    {
+        int words;
+        int countField;
+    };
+    static constexpr int kFixed = -1;
+    static constexpr std::array<Schema, static_cast<size_t>(Type::Count)> kSchemas = {{
+        {0, kFixed},             // Unknown
+        {CoreLoads, Cores},      // Measurements
+        {1, kFixed},             // Snake
+        {Argument + 1, kFixed},  // SetPollInterval
+        {RequestId + 1, kFixed}, // Reconnect
+        {Argument + 1, kFixed},  // Response
+    }};
+
     Type type = Type::Unknown;
-    std::array<uint32_t, 32> data;
+    std::array<uint32_t, CoreLoads + kMaxCores / 4> data;
 
-    static const std::map<Message::Type, int> Size;
+    // Words of data in use.
+    constexpr int Length() const
+    {
+        auto index = static_cast<size_t>(type);
+        if (index >= kSchemas.size()) {
+            return 0;
+        }
+        auto schema = kSchemas[index];
+        if (schema.countField == kFixed) {
+            return schema.words;
+        }
+        int bytes = std::min<uint32_t>(data[schema.countField], (data.size() - schema.words) * 4);
+        return schema.words + (bytes + 3) / 4;
+    }
+    uint8_t CoreLoad(int core) const;
+    void SetCoreLoad(int core, uint8_t load);
+    // Copies the words in use only.
+    void CopyTo(Message& other) const;
 };
 
+// Core1 side of the message ring. Messages are read in place in the ring slot.
 class Receiver
 {
 public:
+    // The message stays valid until the next call.
     Message* Process();
 
 private:
-    enum class State { Idle, Receiving };
-    uint64_t idleTimeoutMs_ = 5;
-    State state_ = State::Idle;
-    Message message_;
-    int received_ = 0;
-    int toReceive_ = 0;
+    Message* current_ = nullptr;
 };
 
+// Core0 side of the message ring. Messages that find the ring full wait in a small fixed queue,
+// where the latest Measurements replace queued ones. A full queue drops its oldest entry, but
+// never a Response: a lost response would leave its call pending on core1. When only responses
+// are queued, a new message is rejected and the sender keeps it.
 class Sender
 {
 public:
+    enum class Result { Delivered, Queued, Coalesced, DroppedOldest, Rejected };
+
+    struct Stats
+    {
+        size_t depth = 0;
+        uint32_t delivered = 0;
+        uint32_t drops = 0;
+        uint32_t coalesced = 0;
+    };
+
     static Sender& GetInstance()
     {
         static Sender instance;
         return instance;
     }
-    void Send(const Message& message);
+    // Slot of the ring to build a message in, nullptr when the ring is full or messages are
+    // queued.
+    Message* Reserve();
+    // Hands the reserved slot over to core1.
+    void Publish();
+    // Never blocks, anything but Delivered means that core1 is behind.
+    Result TrySend(const Message& message);
+    // Moves queued messages into the ring as core1 frees slots.
     void Process();
+    Stats GetStats() const;
+
 private:
+    enum class Policy { Coalesce, DropOldest, Keep };
+    static constexpr size_t kQueueSize = 4;
+
     Sender() = default;
-    std::list<Message> messages_;
+    static Policy policy(Message::Type type);
+    Message& queued(size_t index);
+    // Drops the oldest queued message that may be lost, false when there is none.
+    bool dropOldest();
+
+    std::array<Message, kQueueSize> queue_;
+    size_t start_ = 0;
+    size_t size_ = 0;
+    Stats stats_;
 };
 } // namespace mini_lcd
@@ -0,0 +1,142 @@
+#include "CpuStats.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mini_lcd
+{
+namespace
+{
+// Hosts with up to this many cores are sorted with a fixed network, larger ones are counted
+// into a histogram of the 101 possible loads.
+constexpr int kNetworkSize = 16;
+constexpr int kSmoothingShift = 3;
+
+// Comparators of Batcher's odd-even merge sort, generated at compile time.
+template <int N>
+constexpr int networkSize()
+{
+    int count = 0;
+    for (int p = 1; p < N; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1) {
+            for (int j = k % p; j + k < N; j += 2 * k) {
+                for (int i = 0; i < std::min(k, N - j - k); ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        ++count;
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+template <int N>
+constexpr auto network()
+{
+    std::array<std::pair<uint8_t, uint8_t>, networkSize<N>()> comparators{};
+    int count = 0;
+    for (int p = 1; p < N; p <<= 1) {
+        for (int k = p; k >= 1; k >>= 1) {
+            for (int j = k % p; j + k < N; j += 2 * k) {
+                for (int i = 0; i < std::min(k, N - j - k); ++i) {
+                    if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+                        comparators[count++] = {i + j, i + j + k};
+                    }
+                }
+            }
+        }
+    }
+    return comparators;
+}
+
+constexpr auto sortingNetwork = network<kNetworkSize>();
+
+// Sorts highest first, the comparators do not depend on the data.
+void sortDescending(std::array<uint8_t, kNetworkSize>& values)
+{
+    for (auto [a, b] : sortingNetwork) {
+        uint8_t high = std::max(values[a], values[b]);
+        values[b] = std::min(values[a], values[b]);
+        values[a] = high;
+    }
+}
+} // namespace
+
+CpuStats::Summary CpuStats::Update(const Message& msg, uint8_t* ranks)
+{
+    int cores = std::min<int>(msg.data[Message::Cores], Message::kMaxCores);
+    // Padding with zeros keeps the real loads in front after a descending sort.
+    std::array<uint8_t, kNetworkSize> sorted{};
+    std::array<uint16_t, 101> histogram{};
+    uint32_t sum = 0;
+    uint16_t hottest = 0;
+    hottest_ = 0;
+    for (int core = 0; core < cores; ++core) {
+        uint8_t load = std::min<uint8_t>(msg.CoreLoad(core), 100);
+        sum += load;
+        if (cores <= kNetworkSize) {
+            sorted[core] = load;
+        } else {
+            ++histogram[load];
+        }
+
+        // A core that just appeared starts at its current load.
+        int32_t target = load << 8;
+        int32_t current = core < cores_ ? smoothed_[core] : target;
+        smoothed_[core] = current + ((target - current) >> kSmoothingShift);
+        if (smoothed_[core] > hottest) {
+            hottest = smoothed_[core];
+            hottest_ = core;
+        }
+    }
+    cores_ = cores;
+
+    Summary summary;
+    if (cores == 0) {
+        std::fill(ranks, ranks + kRanks, 0);
+        return summary;
+    }
+
+    // Load at the given position counting from the highest.
+    auto nth = [&](int index) {
+        if (cores <= kNetworkSize) {
+            return sorted[index];
+        }
+        int seen = 0;
+        int load = 100;
+        while (load > 0 && seen + histogram[load] <= index) {
+            seen += histogram[load--];
+        }
+        return static_cast<uint8_t>(load);
+    };
+    if (cores <= kNetworkSize) {
+        sortDescending(sorted);
+    }
+
+    for (int k = 0; k < kRanks; ++k) {
+        ranks[k] = nth(k * (cores - 1) / (kRanks - 1));
+    }
+    summary.max = nth(0);
+    summary.p90 = nth((cores - 1) / 10);
+    summary.median = nth((cores - 1) / 2);
+    summary.min = nth(cores - 1);
+    summary.mean = sum / cores;
+    return summary;
+}
+
+int CpuStats::Cores() const
+{
+    return cores_;
+}
+
+uint8_t CpuStats::Smoothed(int core) const
+{
+    return (smoothed_[core] + 128) >> 8;
+}
+
+int CpuStats::Hottest() const
+{
+    return hottest_;
+}
+} // namespace mini_lcd
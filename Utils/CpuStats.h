@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Comm.h"
+
+#include <array>
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Cross-core statistics of a measurement, computed once when the sample arrives so that the
+// renderers only read stored values.
+class CpuStats
+{
+public:
+    // Load quantiles per sample, highest first.
+    static constexpr int kRanks = 16;
+
+    struct Summary
+    {
+        uint8_t min = 0;
+        uint8_t median = 0;
+        uint8_t p90 = 0;
+        uint8_t max = 0;
+        uint8_t mean = 0;
+    };
+
+    // Loads are clamped to 0...100. Fills ranks with kRanks evenly spaced quantiles.
+    Summary Update(const Message& msg, uint8_t* ranks);
+
+    int Cores() const;
+    // Exponentially weighted load of a core, smoothing over about eight samples.
+    uint8_t Smoothed(int core) const;
+    // Core with the highest smoothed load.
+    int Hottest() const;
+
+private:
+    // 8.8 fixed point.
+    std::array<uint16_t, Message::kMaxCores> smoothed_{};
+    int cores_ = 0;
+    int hottest_ = 0;
+};
+} // namespace mini_lcd
@@ -0,0 +1,131 @@
+#include "FlashLog.h"
+#include "Logger.h"
+#include "Utils.h"
+
+#include <pico/flash.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace mini_lcd
+{
+namespace
+{
+constexpr uint32_t kMagic = 0x474F4C46; // "FLOG"
+constexpr uint32_t kLockoutTimeoutMs = 100;
+
+struct Program
+{
+    uint32_t offset;
+    const uint8_t* data;
+};
+
+// Runs with the other core parked and interrupts disabled.
+void programSector(void* param)
+{
+    auto program = static_cast<const Program*>(param);
+    flash_range_erase(program->offset, FLASH_SECTOR_SIZE);
+    flash_range_program(program->offset, program->data, FLASH_SECTOR_SIZE);
+}
+
+// Flash is not readable while a sector is programmed, so the data is staged in RAM.
+alignas(4) uint8_t sectorBuffer[FLASH_SECTOR_SIZE];
+} // namespace
+
+FlashLog::FlashLog(uint32_t version, size_t size)
+    : version_(version)
+    , size_(size)
+    , slotSize_((sizeof(Header) + size + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE *
+                FLASH_SECTOR_SIZE)
+    , slots_(kRegionSize / slotSize_)
+    , latest_(slots_)
+{
+    if (!slots_) {
+        Logger::error() << "Flash log record of " << size << " bytes exceeds the region\n";
+        return;
+    }
+    for (size_t i = 0; i < slots_; ++i) {
+        if (!valid(i)) {
+            continue;
+        }
+        Header header;
+        memcpy(&header, slot(i), sizeof(header));
+        // Sequence numbers are compared by difference so that they may wrap around.
+        if (latest_ == slots_ || static_cast<int32_t>(header.sequence - sequence_) > 0) {
+            latest_ = i;
+            sequence_ = header.sequence;
+        }
+    }
+    Logger::info() << "Flash log: " << slots_ << " slots, latest "
+                   << (latest_ == slots_ ? -1 : static_cast<int>(latest_)) << "\n";
+}
+
+std::span<const uint8_t> FlashLog::Latest() const
+{
+    if (latest_ == slots_) {
+        return {};
+    }
+    return {slot(latest_) + sizeof(Header), size_};
+}
+
+bool FlashLog::Append(std::span<const std::span<uint8_t>> parts)
+{
+    Header header{kMagic, version_, sequence_ + 1, 0, 0};
+    for (auto part : parts) {
+        header.size += part.size();
+        header.crc = Utils::crc32(part.data(), part.size(), header.crc);
+    }
+    if (!slots_ || header.size != size_) {
+        Logger::error() << "Flash log record of " << header.size << " bytes, expected " << size_
+                        << "\n";
+        return false;
+    }
+
+    size_t index = latest_ == slots_ ? 0 : (latest_ + 1) % slots_;
+    uint32_t offset = kRegionOffset + index * slotSize_;
+    auto part = parts.begin();
+    size_t consumed = 0;
+    for (size_t sector = 0; sector < slotSize_ / FLASH_SECTOR_SIZE; ++sector) {
+        size_t filled = 0;
+        // The header goes first, a record torn after it fails the CRC check.
+        if (sector == 0) {
+            memcpy(sectorBuffer, &header, sizeof(header));
+            filled = sizeof(header);
+        }
+        while (filled < FLASH_SECTOR_SIZE && part != parts.end()) {
+            size_t count = std::min(FLASH_SECTOR_SIZE - filled, part->size() - consumed);
+            memcpy(sectorBuffer + filled, part->data() + consumed, count);
+            filled += count;
+            consumed += count;
+            if (consumed == part->size()) {
+                ++part;
+                consumed = 0;
+            }
+        }
+        std::fill(sectorBuffer + filled, sectorBuffer + FLASH_SECTOR_SIZE, 0xFF);
+
+        Program program{offset + static_cast<uint32_t>(sector * FLASH_SECTOR_SIZE), sectorBuffer};
+        int result = flash_safe_execute(programSector, &program, kLockoutTimeoutMs);
+        if (result != PICO_OK) {
+            Logger::error() << "Flash log write failed: " << result << "\n";
+            return false;
+        }
+    }
+    latest_ = index;
+    sequence_ = header.sequence;
+    return true;
+}
+
+const uint8_t* FlashLog::slot(size_t index) const
+{
+    return reinterpret_cast<const uint8_t*>(XIP_BASE + kRegionOffset + index * slotSize_);
+}
+
+bool FlashLog::valid(size_t index) const
+{
+    Header header;
+    memcpy(&header, slot(index), sizeof(header));
+    return header.magic == kMagic && header.version == version_ && header.size == size_ &&
+           header.crc == Utils::crc32(slot(index) + sizeof(Header), size_);
+}
+} // namespace mini_lcd
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <pico/stdlib.h>
+#include <hardware/flash.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mini_lcd
+{
+// Circular log of records in a flash region reserved at the end of the flash. Each record takes
+// whole sectors and the slots are written round robin, so every sector is erased once per pass
+// over the region. A record carries a sequence number and a CRC, a torn write is ignored and the
+// previous record is used instead.
+//
+// Writing pauses the other core and interrupts for every sector, the other core has to call
+// flash_safe_execute_core_init() at startup, before this core is launched. A 4 KiB sector erase
+// takes tens of milliseconds, and for that long the other core runs no lwIP timers and takes no
+// interrupts.
+class FlashLog
+{
+public:
+    static constexpr uint32_t kRegionSize = 24 * FLASH_SECTOR_SIZE;
+    static constexpr uint32_t kRegionOffset = PICO_FLASH_SIZE_BYTES - kRegionSize;
+
+    // Records of one version and size, the newest one is located by the constructor.
+    FlashLog(uint32_t version, size_t size);
+
+    // Payload of the newest valid record, read in place from XIP flash.
+    std::span<const uint8_t> Latest() const;
+    // Writes the parts one after another as a new record.
+    bool Append(std::span<const std::span<uint8_t>> parts);
+
+private:
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t sequence;
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    const uint8_t* slot(size_t index) const;
+    bool valid(size_t index) const;
+
+    const uint32_t version_;
+    const size_t size_;
+    const size_t slotSize_;
+    const size_t slots_;
+    // Slot of the newest valid record, slots_ when there is none.
+    size_t latest_;
+    uint32_t sequence_ = 0;
+};
+} // namespace mini_lcd
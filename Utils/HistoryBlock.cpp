@@ -0,0 +1,167 @@
+#include "HistoryBlock.h"
+
+#include <algorithm>
+
+namespace mini_lcd
+{
+namespace
+{
+// Worst case frame: longest timestamp code plus the longest value code for every channel.
+constexpr size_t kMaxTimeBits = 3 + 32;
+constexpr size_t kMaxValueBits = 3 + 8;
+
+uint32_t zigzag(int32_t value)
+{
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value)
+{
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+} // namespace
+
+void HistoryBlock::Reset(uint8_t channels)
+{
+    channels_ = std::min(channels, kMaxChannels);
+    bits_ = 0;
+    frames_ = 0;
+    seconds_ = 0;
+    delta_ = 0;
+    values_.fill(0);
+}
+
+bool HistoryBlock::Append(uint32_t seconds, const uint8_t* values)
+{
+    if (bits_ + kMaxTimeBits + channels_ * kMaxValueBits > kSize * 8) {
+        return false;
+    }
+
+    // Timestamp: the first one verbatim, then the change of the interval.
+    if (frames_ == 0) {
+        write(seconds, 32);
+    } else {
+        int32_t delta = seconds - seconds_;
+        uint32_t dod = zigzag(delta - delta_);
+        if (dod == 0) {
+            write(0b0, 1);
+        } else if (dod < (1 << 7)) {
+            write(0b10, 2);
+            write(dod, 7);
+        } else if (dod < (1 << 12)) {
+            write(0b110, 3);
+            write(dod, 12);
+        } else {
+            write(0b111, 3);
+            write(dod, 32);
+        }
+        delta_ = delta;
+    }
+    seconds_ = seconds;
+
+    // Values: change against the previous frame, the first frame is relative to zero.
+    for (uint8_t i = 0; i < channels_; ++i) {
+        uint32_t change = zigzag(values[i] - values_[i]);
+        if (change == 0) {
+            write(0b0, 1);
+        } else if (change < (1 << 3)) {
+            write(0b10, 2);
+            write(change, 3);
+        } else if (change < (1 << 5)) {
+            write(0b110, 3);
+            write(change, 5);
+        } else {
+            write(0b111, 3);
+            write(change, 9);
+        }
+        values_[i] = values[i];
+    }
+
+    ++frames_;
+    return true;
+}
+
+uint16_t HistoryBlock::Frames() const
+{
+    return frames_;
+}
+
+uint8_t HistoryBlock::Channels() const
+{
+    return channels_;
+}
+
+size_t HistoryBlock::Bytes() const
+{
+    return (bits_ + 7) / 8;
+}
+
+void HistoryBlock::write(uint32_t value, uint8_t bits)
+{
+    // Most significant bit first, bytes are filled from their top bit.
+    for (int bit = bits - 1; bit >= 0; --bit) {
+        auto& byte = data_[bits_ / 8];
+        uint8_t mask = 0x80 >> (bits_ % 8);
+        byte = (value >> bit) & 1 ? byte | mask : byte & ~mask;
+        ++bits_;
+    }
+}
+
+HistoryBlock::Reader::Reader(const HistoryBlock& block)
+    : block_(block)
+{
+}
+
+uint32_t HistoryBlock::Reader::read(uint8_t bits)
+{
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bits; ++i) {
+        value = (value << 1) | ((block_.data_[position_ / 8] >> (7 - position_ % 8)) & 1);
+        ++position_;
+    }
+    return value;
+}
+
+bool HistoryBlock::Reader::Next(uint32_t& seconds, uint8_t* values)
+{
+    if (frame_ == block_.frames_) {
+        return false;
+    }
+
+    if (frame_ == 0) {
+        seconds_ = read(32);
+    } else {
+        uint32_t dod = 0;
+        if (read(1)) {
+            if (!read(1)) {
+                dod = read(7);
+            } else if (!read(1)) {
+                dod = read(12);
+            } else {
+                dod = read(32);
+            }
+        }
+        delta_ += unzigzag(dod);
+        seconds_ += delta_;
+    }
+    seconds = seconds_;
+
+    for (uint8_t i = 0; i < block_.channels_; ++i) {
+        uint32_t change = 0;
+        if (read(1)) {
+            if (!read(1)) {
+                change = read(3);
+            } else if (!read(1)) {
+                change = read(5);
+            } else {
+                change = read(9);
+            }
+        }
+        values_[i] += unzigzag(change);
+        values[i] = values_[i];
+    }
+
+    ++frame_;
+    return true;
+}
+} // namespace mini_lcd
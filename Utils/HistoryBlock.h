@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Append-only compressed block of frames, each frame being a timestamp in seconds and one byte
+// per channel. Timestamps are stored as delta-of-delta and values as zig-zag deltas against the
+// previous frame, both behind short prefix codes, so a regular sample interval costs one bit and
+// an unchanged value one bit. Frames are decoded sequentially with a Reader.
+class HistoryBlock
+{
+public:
+    static constexpr size_t kSize = 1024;
+    static constexpr uint8_t kMaxChannels = 16;
+
+    class Reader
+    {
+    public:
+        explicit Reader(const HistoryBlock& block);
+        // Returns false after the last frame.
+        bool Next(uint32_t& seconds, uint8_t* values);
+
+    private:
+        uint32_t read(uint8_t bits);
+
+        const HistoryBlock& block_;
+        size_t position_ = 0;
+        uint16_t frame_ = 0;
+        uint32_t seconds_ = 0;
+        int32_t delta_ = 0;
+        std::array<uint8_t, kMaxChannels> values_{};
+    };
+
+    void Reset(uint8_t channels);
+    // Returns false and leaves the block unchanged when the frame might not fit.
+    bool Append(uint32_t seconds, const uint8_t* values);
+
+    uint16_t Frames() const;
+    uint8_t Channels() const;
+    size_t Bytes() const;
+
+private:
+    void write(uint32_t value, uint8_t bits);
+
+    std::array<uint8_t, kSize> data_{};
+    size_t bits_ = 0;
+    uint16_t frames_ = 0;
+    uint8_t channels_ = 0;
+    uint32_t seconds_ = 0;
+    int32_t delta_ = 0;
+    std::array<uint8_t, kMaxChannels> values_{};
+};
+
+// Ring of compressed blocks, the oldest block is dropped when all are full.
+template <size_t Blocks>
+class CompressedHistory
+{
+public:
+    explicit CompressedHistory(uint8_t channels)
+        : channels_(channels)
+    {
+        blocks_[0].Reset(channels_);
+    }
+
+    void Append(uint32_t seconds, const uint8_t* values)
+    {
+        if (blocks_[last()].Append(seconds, values)) {
+            return;
+        }
+        if (count_ == Blocks) {
+            first_ = (first_ + 1) % Blocks;
+        } else {
+            ++count_;
+        }
+        blocks_[last()].Reset(channels_);
+        blocks_[last()].Append(seconds, values);
+    }
+
+    size_t Frames() const
+    {
+        size_t frames = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            frames += blocks_[(first_ + i) % Blocks].Frames();
+        }
+        return frames;
+    }
+
+    size_t Bytes() const
+    {
+        size_t bytes = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            bytes += blocks_[(first_ + i) % Blocks].Bytes();
+        }
+        return bytes;
+    }
+
+    // Calls f(seconds, values) for the newest frames, oldest first. Blocks before the ones needed
+    // are skipped without decoding.
+    template <typename F>
+    void ForEachLast(size_t frames, F&& f) const
+    {
+        size_t skip = 0;
+        size_t block = count_;
+        size_t available = 0;
+        while (block > 0 && available < frames) {
+            available += blocks_[(first_ + --block) % Blocks].Frames();
+        }
+        if (available > frames) {
+            skip = available - frames;
+        }
+
+        uint32_t seconds;
+        std::array<uint8_t, HistoryBlock::kMaxChannels> values;
+        for (; block < count_; ++block) {
+            HistoryBlock::Reader reader(blocks_[(first_ + block) % Blocks]);
+            while (reader.Next(seconds, values.data())) {
+                if (skip) {
+                    --skip;
+                    continue;
+                }
+                f(seconds, values.data());
+            }
+        }
+    }
+
+private:
+    size_t last() const
+    {
+        return (first_ + count_ - 1) % Blocks;
+    }
+
+    std::array<HistoryBlock, Blocks> blocks_;
+    size_t first_ = 0;
+    size_t count_ = 1;
+    uint8_t channels_;
+};
+} // namespace mini_lcd
@@ -0,0 +1,198 @@
+#include "HttpResponseParser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+
+namespace mini_lcd
+{
+namespace
+{
+bool equalsIgnoreCase(std::string_view a, std::string_view b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+        [](char x, char y) { return tolower(x) == tolower(y); });
+}
+
+std::string_view trim(std::string_view text)
+{
+    text.remove_prefix(std::min(text.find_first_not_of(" \t"), text.size()));
+    text.remove_suffix(text.size() - std::min(text.find_last_not_of(" \t") + 1, text.size()));
+    return text;
+}
+} // namespace
+
+HttpResponseParser::HttpResponseParser(Callback callback) : callback_(std::move(callback))
+{
+}
+
+void HttpResponseParser::Reset()
+{
+    part_ = Part::Status;
+    lineSize_ = 0;
+    status_ = 0;
+    lengthKnown_ = false;
+    chunked_ = false;
+    bodyLeft_ = 0;
+    lastOnConnection_ = false;
+}
+
+bool HttpResponseParser::Feed(std::string_view data)
+{
+    // Pipelined responses follow each other in the order of the requests.
+    while (!data.empty() && part_ != Part::Closing && part_ != Part::Failed) {
+        if (part_ == Part::Body || part_ == Part::Chunk) {
+            bool bounded = part_ == Part::Chunk || lengthKnown_;
+            auto piece = bounded ? data.substr(0, bodyLeft_) : data;
+            callback_(Event::Body, piece);
+            data.remove_prefix(piece.size());
+            if (bounded && (bodyLeft_ -= piece.size()) == 0) {
+                if (part_ == Part::Chunk) {
+                    part_ = Part::ChunkEnd;
+                } else {
+                    end();
+                }
+            }
+            continue;
+        }
+        auto newline = data.find('\n');
+        auto text = data.substr(0, newline);
+        auto copied = std::min(text.size(), line_.size() - lineSize_);
+        std::copy_n(text.begin(), copied, line_.begin() + lineSize_);
+        lineSize_ += copied;
+        if (newline == std::string_view::npos) {
+            break;
+        }
+        data.remove_prefix(newline + 1);
+        bool framed = line({line_.data(), lineSize_});
+        lineSize_ = 0;
+        if (!framed) {
+            part_ = Part::Failed;
+        }
+    }
+    return part_ != Part::Failed;
+}
+
+void HttpResponseParser::Closed()
+{
+    if (part_ == Part::Body && !lengthKnown_) {
+        end();
+    }
+}
+
+int HttpResponseParser::Status() const
+{
+    return status_;
+}
+
+bool HttpResponseParser::Closing() const
+{
+    return part_ == Part::Closing;
+}
+
+bool HttpResponseParser::line(std::string_view line)
+{
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+    switch (part_) {
+        case Part::Status: {
+            // HTTP/1.1 200 OK
+            constexpr std::string_view version = "HTTP/1.x ";
+            if (!line.starts_with("HTTP/1.") || line.size() < version.size() + 3) {
+                return false;
+            }
+            auto code = line.substr(version.size(), 3);
+            if (std::from_chars(code.data(), code.data() + code.size(), status_).ec !=
+                std::errc{}) {
+                return false;
+            }
+            lastOnConnection_ = line.starts_with("HTTP/1.0");
+            lengthKnown_ = false;
+            chunked_ = false;
+            bodyLeft_ = 0;
+            part_ = Part::Headers;
+            return true;
+        }
+        case Part::Headers: {
+            if (line.empty()) {
+                start();
+                return true;
+            }
+            auto colon = line.find(':');
+            if (colon != std::string_view::npos) {
+                header(line.substr(0, colon), trim(line.substr(colon + 1)));
+            }
+            return true;
+        }
+        case Part::ChunkSize:
+            return chunkSize(line);
+        case Part::ChunkEnd:
+            part_ = Part::ChunkSize;
+            return line.empty();
+        case Part::Trailers:
+            // Trailer fields are ignored, the empty line ends the response.
+            if (line.empty()) {
+                end();
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+void HttpResponseParser::header(std::string_view name, std::string_view value)
+{
+    if (equalsIgnoreCase(name, "Content-Length")) {
+        lengthKnown_ = std::from_chars(value.data(), value.data() + value.size(), bodyLeft_).ec ==
+            std::errc{};
+    } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+        // The body is chunked when chunked is the last coding applied.
+        auto comma = value.rfind(',');
+        chunked_ = equalsIgnoreCase(
+            trim(comma == std::string_view::npos ? value : value.substr(comma + 1)), "chunked");
+    } else if (equalsIgnoreCase(name, "Connection")) {
+        lastOnConnection_ = equalsIgnoreCase(value.substr(0, 5), "close");
+    }
+}
+
+bool HttpResponseParser::chunkSize(std::string_view line)
+{
+    // Chunk extensions are ignored.
+    auto size = trim(line.substr(0, line.find(';')));
+    auto [end, ec] = std::from_chars(size.data(), size.data() + size.size(), bodyLeft_, 16);
+    if (size.empty() || ec != std::errc{} || end != size.data() + size.size()) {
+        return false;
+    }
+    part_ = bodyLeft_ ? Part::Chunk : Part::Trailers;
+    return true;
+}
+
+void HttpResponseParser::start()
+{
+    // These never have a body, whatever the headers say.
+    if (status_ == 204 || status_ == 304) {
+        chunked_ = false;
+        lengthKnown_ = true;
+        bodyLeft_ = 0;
+    }
+    if (chunked_) {
+        // Content-Length does not count with chunks.
+        lengthKnown_ = false;
+    } else if (!lengthKnown_) {
+        // The body ends with the connection.
+        lastOnConnection_ = true;
+    }
+    callback_(Event::Start, {});
+    part_ = chunked_ ? Part::ChunkSize : Part::Body;
+    if (part_ == Part::Body && lengthKnown_ && bodyLeft_ == 0) {
+        end();
+    }
+}
+
+void HttpResponseParser::end()
+{
+    callback_(Event::End, {});
+    part_ = lastOnConnection_ ? Part::Closing : Part::Status;
+}
+} // namespace mini_lcd
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace mini_lcd
+{
+// Frames the HTTP/1.x responses arriving on one keep-alive connection. The input is fed in pieces
+// of any size, for example the payloads of a pbuf chain, and pipelined responses follow each
+// other in the same stream. Bodies are delimited by Content-Length, by chunked transfer coding or
+// by the end of the connection, and are handed on as they arrive. Nothing is buffered but one
+// header or chunk size line.
+class HttpResponseParser
+{
+public:
+    // Start follows the headers, Body carries the body in pieces, chunk framing removed, and End
+    // follows the last byte of the body. The data is only valid during the call.
+    enum class Event { Start, Body, End };
+    using Callback = std::function<void(Event event, std::string_view data)>;
+
+    explicit HttpResponseParser(Callback callback);
+
+    // Starts over for a new connection.
+    void Reset();
+    // Returns false once the stream cannot be framed, the connection has to be closed. Nothing
+    // after the last response on the connection is consumed.
+    bool Feed(std::string_view data);
+    // The server closed the connection, which ends a body without a length.
+    void Closed();
+
+    // Status code of the response being parsed or the one that just ended.
+    int Status() const;
+    // The response just ended is the last one, the connection has to be closed.
+    bool Closing() const;
+
+private:
+    enum class Part : uint8_t {
+        Status,
+        Headers,
+        Body,     // Content-Length or until the connection closes
+        ChunkSize,
+        Chunk,
+        ChunkEnd, // the line break after the chunk data
+        Trailers,
+        Closing,
+        Failed
+    };
+
+    bool line(std::string_view line);
+    void header(std::string_view name, std::string_view value);
+    bool chunkSize(std::string_view line);
+    void start();
+    void end();
+
+    Callback callback_;
+    Part part_ = Part::Status;
+    // Long lines are truncated, only the start of the few that matter is looked at.
+    std::array<char, 64> line_{};
+    size_t lineSize_ = 0;
+    int status_ = 0;
+    bool lengthKnown_ = false;
+    bool chunked_ = false;
+    // Body or chunk bytes still due.
+    size_t bodyLeft_ = 0;
+    bool lastOnConnection_ = false;
+};
+} // namespace mini_lcd
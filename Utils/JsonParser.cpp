@@ -0,0 +1,313 @@
+#include "JsonParser.h"
+
+#include <algorithm>
+
+namespace mini_lcd
+{
+namespace
+{
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isBare(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == '-' || c == '+' || c == '.' ||
+        c == 'E';
+}
+
+int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+} // namespace
+
+JsonParser::JsonParser(Callback callback) : callback_(std::move(callback))
+{
+}
+
+void JsonParser::Reset()
+{
+    state_ = State::Value;
+    depth_ = 0;
+    objects_ = 0;
+    escape_ = false;
+    unicodeDigits_ = 0;
+    keySize_ = 0;
+    tokenSize_ = 0;
+    overflow_ = false;
+    skipDepth_ = -1;
+}
+
+bool JsonParser::Feed(std::string_view data)
+{
+    for (auto c : data) {
+        if (state_ == State::Failed) {
+            break;
+        }
+        if (!step(c)) {
+            state_ = State::Failed;
+        }
+    }
+    return state_ != State::Failed;
+}
+
+bool JsonParser::Done() const
+{
+    return state_ == State::Done;
+}
+
+bool JsonParser::Failed() const
+{
+    return state_ == State::Failed;
+}
+
+bool JsonParser::step(char c)
+{
+    switch (state_) {
+        case State::KeyString:
+        case State::String:
+            return stringChar(c);
+        case State::Bare:
+            if (isBare(c)) {
+                append(c);
+                return true;
+            }
+            // The character after the token is handled in the state the token leaves behind.
+            if (!endBare()) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (isSpace(c)) {
+        return true;
+    }
+    switch (state_) {
+        case State::ValueOrEnd:
+            if (c == ']') {
+                return closeContainer(false);
+            }
+            return startValue(c);
+        case State::Value:
+            return startValue(c);
+        case State::KeyOrEnd:
+            if (c == '}') {
+                return closeContainer(true);
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (c != '"') {
+                return false;
+            }
+            keySize_ = 0;
+            overflow_ = false;
+            state_ = State::KeyString;
+            return true;
+        case State::Colon:
+            if (c != ':') {
+                return false;
+            }
+            state_ = State::Value;
+            return true;
+        case State::AfterValue:
+            if (c == ',') {
+                state_ = inObject() ? State::Key : State::Value;
+                return true;
+            }
+            if (c == '}' || c == ']') {
+                return closeContainer(c == '}');
+            }
+            return false;
+        default:
+            return false;
+    }
+}
+
+bool JsonParser::startValue(char c)
+{
+    if (c == '{' || c == '[') {
+        if (depth_ == kMaxDepth) {
+            return false;
+        }
+        emit(c == '{' ? Event::ObjectStart : Event::ArrayStart);
+        objects_ = c == '{' ? objects_ | (1u << depth_) : objects_ & ~(1u << depth_);
+        ++depth_;
+        state_ = c == '{' ? State::KeyOrEnd : State::ValueOrEnd;
+        return true;
+    }
+    tokenSize_ = 0;
+    overflow_ = false;
+    if (c == '"') {
+        state_ = State::String;
+        return true;
+    }
+    if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+        state_ = State::Bare;
+        append(c);
+        return true;
+    }
+    return false;
+}
+
+bool JsonParser::stringChar(char c)
+{
+    if (unicodeDigits_) {
+        auto value = hexValue(c);
+        if (value < 0) {
+            return false;
+        }
+        codePoint_ = codePoint_ * 16 + value;
+        if (--unicodeDigits_ == 0) {
+            appendUtf8(codePoint_);
+        }
+        return true;
+    }
+    if (escape_) {
+        escape_ = false;
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                append(c);
+                return true;
+            case 'b':
+                append('\b');
+                return true;
+            case 'f':
+                append('\f');
+                return true;
+            case 'n':
+                append('\n');
+                return true;
+            case 'r':
+                append('\r');
+                return true;
+            case 't':
+                append('\t');
+                return true;
+            case 'u':
+                unicodeDigits_ = 4;
+                codePoint_ = 0;
+                return true;
+            default:
+                return false;
+        }
+    }
+    if (c == '\\') {
+        escape_ = true;
+        return true;
+    }
+    if (c == '"') {
+        if (state_ == State::KeyString) {
+            if (overflow_ && skipDepth_ < 0) {
+                skipDepth_ = depth_;
+            }
+            state_ = State::Colon;
+        } else {
+            if (!overflow_) {
+                emit(Event::String, {token_.data(), tokenSize_});
+            }
+            valueDone();
+        }
+        return true;
+    }
+    if (static_cast<unsigned char>(c) < 0x20) {
+        return false;
+    }
+    append(c);
+    return true;
+}
+
+bool JsonParser::endBare()
+{
+    std::string_view token{token_.data(), tokenSize_};
+    if (token[0] == 't' || token[0] == 'f' || token[0] == 'n') {
+        if (token != "true" && token != "false" && token != "null") {
+            return false;
+        }
+        emit(Event::Literal, token);
+    } else {
+        if (token.find_first_not_of("0123456789-+.eE") != std::string_view::npos) {
+            return false;
+        }
+        if (!overflow_) {
+            emit(Event::Number, token);
+        }
+    }
+    valueDone();
+    return true;
+}
+
+bool JsonParser::closeContainer(bool object)
+{
+    if (depth_ == 0 || inObject() != object) {
+        return false;
+    }
+    --depth_;
+    emit(object ? Event::ObjectEnd : Event::ArrayEnd);
+    valueDone();
+    return true;
+}
+
+void JsonParser::valueDone()
+{
+    if (depth_ == skipDepth_) {
+        skipDepth_ = -1;
+    }
+    state_ = depth_ == 0 ? State::Done : State::AfterValue;
+}
+
+void JsonParser::append(char c)
+{
+    auto& buffer = state_ == State::KeyString ? key_ : token_;
+    auto& size = state_ == State::KeyString ? keySize_ : tokenSize_;
+    if (size < buffer.size()) {
+        buffer[size++] = c;
+    } else {
+        overflow_ = true;
+    }
+}
+
+void JsonParser::appendUtf8(uint32_t codePoint)
+{
+    // Surrogate pairs are not combined, each half is encoded on its own.
+    if (codePoint < 0x80) {
+        append(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+        append(static_cast<char>(0xC0 | (codePoint >> 6)));
+        append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+        append(static_cast<char>(0xE0 | (codePoint >> 12)));
+        append(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        append(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+bool JsonParser::inObject() const
+{
+    return depth_ > 0 && (objects_ & (1u << (depth_ - 1)));
+}
+
+void JsonParser::emit(Event event, std::string_view value)
+{
+    if (!callback_ || skipDepth_ >= 0) {
+        return;
+    }
+    bool member = inObject() && event != Event::ObjectEnd && event != Event::ArrayEnd;
+    callback_(event, depth_, member ? std::string_view{key_.data(), keySize_} : std::string_view{},
+        value);
+}
+} // namespace mini_lcd
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace mini_lcd
+{
+// Incremental JSON parser that reports the document as a stream of events instead of building a
+// tree. The input is fed in pieces of any size, for example the payloads of a pbuf chain, and
+// parsing resumes in the middle of a token. The state does not grow with the document: the
+// nesting is one bit per level, keys and scalar values are collected in small buffers. Nothing is
+// truncated: a member whose key does not fit is skipped with everything in its value, and a
+// scalar that does not fit is skipped on its own.
+class JsonParser
+{
+public:
+    enum class Event { ObjectStart, ObjectEnd, ArrayStart, ArrayEnd, String, Number, Literal };
+    // Depth is the number of containers around the value. The key is the member name inside an
+    // object, empty in arrays and for the end events. The value is the text of a scalar, with the
+    // escapes of strings resolved. The views are only valid during the call.
+    using Callback =
+        std::function<void(Event event, int depth, std::string_view key, std::string_view value)>;
+
+    static constexpr int kMaxDepth = 32;
+    static constexpr size_t kMaxToken = 24;
+
+    explicit JsonParser(Callback callback);
+
+    // Starts over with a new document.
+    void Reset();
+    // Returns false once the document turned out malformed, further input is ignored until the
+    // next Reset(). A number at the top level only ends with the character after it.
+    bool Feed(std::string_view data);
+    // A complete top-level value has been parsed.
+    bool Done() const;
+    bool Failed() const;
+
+private:
+    enum class State : uint8_t {
+        Value,      // a value is due
+        ValueOrEnd, // after '[', a value or ']'
+        KeyOrEnd,   // after '{', a key or '}'
+        Key,        // after ',' in an object
+        KeyString,
+        Colon,
+        String,
+        Bare, // number or literal
+        AfterValue,
+        Done,
+        Failed
+    };
+
+    bool step(char c);
+    bool startValue(char c);
+    bool stringChar(char c);
+    bool endBare();
+    bool closeContainer(bool object);
+    void valueDone();
+    void append(char c);
+    void appendUtf8(uint32_t codePoint);
+    bool inObject() const;
+    void emit(Event event, std::string_view value = {});
+
+    Callback callback_;
+    State state_ = State::Value;
+    int depth_ = 0;
+    // Bit set for an object at that level, clear for an array.
+    uint32_t objects_ = 0;
+    bool escape_ = false;
+    // Hex digits of a \u escape still due.
+    int unicodeDigits_ = 0;
+    uint32_t codePoint_ = 0;
+    std::array<char, kMaxToken> key_{};
+    size_t keySize_ = 0;
+    std::array<char, kMaxToken> token_{};
+    size_t tokenSize_ = 0;
+    // The key or scalar being collected did not fit.
+    bool overflow_ = false;
+    // Depth of the member being skipped, -1 when events are reported.
+    int skipDepth_ = -1;
+};
+} // namespace mini_lcd
@@ -14,6 +14,11 @@ void Logger::SetVerbosity(Verbosity verbosity)
     verbosity_ = verbosity;
 }
 
+Logger::Verbosity Logger::GetVerbosity() const
+{
+    return verbosity_;
+}
+
 Logger& Logger::trace(std::source_location loc)
 {
     return start(loc, Verbosity::Trace);
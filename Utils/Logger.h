@@ -16,6 +16,7 @@ public:
     static Logger& error(std::source_location loc = std::source_location::current());
     static Logger& GetLogger();
     void SetVerbosity(Verbosity verbosity);
+    Verbosity GetVerbosity() const;
 
     template <typename T>
     Logger& operator<<(const T& message)
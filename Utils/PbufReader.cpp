@@ -0,0 +1,31 @@
+#include "PbufReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mini_lcd
+{
+PbufReader::PbufReader(const pbuf* chain)
+    : current_(chain)
+{
+}
+
+uint16_t PbufReader::Read(uint8_t* buffer, uint16_t size)
+{
+    uint16_t done = 0;
+    while (done < size && current_) {
+        uint16_t count = std::min<uint16_t>(size - done, current_->len - offset_);
+        if (buffer) {
+            memcpy(buffer + done, (const uint8_t*)current_->payload + offset_, count);
+        }
+        offset_ += count;
+        done += count;
+        // Step to the next segment as soon as this one is used up, empty segments included.
+        if (offset_ == current_->len) {
+            current_ = current_->next;
+            offset_ = 0;
+        }
+    }
+    return done;
+}
+} // namespace mini_lcd
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "lwip/pbuf.h"
+
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Sequential reader over an lwIP pbuf chain, usable as a hagl_image_reader_t. Bytes are copied
+// straight from the segment payloads into the caller's buffer, so a received image never has to
+// be assembled into one contiguous block. The chain is read as it is when the reader reaches each
+// segment and a short read ends the stream for the decoder, so collect the whole image with
+// pbuf_cat() before decoding. The chain is not owned and must outlive the reader.
+class PbufReader
+{
+public:
+    explicit PbufReader(const pbuf* chain);
+
+    // Returns the number of bytes copied, a null buffer skips instead of copying.
+    uint16_t Read(uint8_t* buffer, uint16_t size);
+
+    static uint16_t Reader(void* context, uint8_t* buffer, uint16_t size)
+    {
+        return ((PbufReader*)context)->Read(buffer, size);
+    }
+
+private:
+    const pbuf* current_ = nullptr;
+    uint16_t offset_ = 0;
+};
+} // namespace mini_lcd
@@ -0,0 +1,120 @@
+#include "Rpc.h"
+#include "Logger.h"
+#include "Utils.h"
+
+#include <algorithm>
+
+namespace mini_lcd
+{
+namespace
+{
+// Core1 produces, core0 consumes.
+SpscRing<Message, 4> requests;
+} // namespace
+
+bool RpcClient::Call(Message request, Callback done, uint32_t timeoutMs)
+{
+    auto pending = std::find_if(
+        pending_.begin(), pending_.end(), [](const Pending& entry) { return entry.id == 0; });
+    auto slot = requests.Reserve();
+    if (pending == pending_.end() || !slot) {
+        Logger::warn() << "RPC " << static_cast<int>(request.type) << " rejected, core0 is busy\n";
+        return false;
+    }
+    request.data[Message::RequestId] = nextId_;
+    pending->id = nextId_;
+    pending->deadline = Utils::millis() + timeoutMs;
+    pending->done = std::move(done);
+    // Zero is the free marker of the table.
+    nextId_ = nextId_ + 1 ? nextId_ + 1 : 1;
+
+    request.CopyTo(*slot);
+    requests.Publish();
+    return true;
+}
+
+void RpcClient::OnResponse(const Message& response)
+{
+    auto id = response.data[Message::RequestId];
+    for (auto& pending : pending_) {
+        if (pending.id == id) {
+            auto done = std::move(pending.done);
+            pending = {};
+            if (done) {
+                done(static_cast<RpcStatus>(response.data[Message::Argument]));
+            }
+            return;
+        }
+    }
+    Logger::warn() << "RPC response " << id << " without a call\n";
+}
+
+void RpcClient::Poll()
+{
+    auto now = Utils::millis();
+    for (auto& pending : pending_) {
+        if (pending.id != 0 && now >= pending.deadline) {
+            Logger::warn() << "RPC " << pending.id << " timed out\n";
+            auto done = std::move(pending.done);
+            pending = {};
+            if (done) {
+                done(RpcStatus::Timeout);
+            }
+        }
+    }
+}
+
+void RpcServer::Handle(Message::Type type, Handler handler)
+{
+    handlers_[static_cast<size_t>(type)] = std::move(handler);
+}
+
+void RpcServer::Process()
+{
+    while (auto response = unsent_.Front()) {
+        if (Sender::GetInstance().TrySend(*response) == Sender::Result::Rejected) {
+            return;
+        }
+        unsent_.Pop();
+    }
+    while (auto request = requests.Front()) {
+        auto index = static_cast<size_t>(request->type);
+        auto status = RpcStatus::Unsupported;
+        if (index < handlers_.size() && handlers_[index]) {
+            status = handlers_[index](*request);
+        }
+        auto id = request->data[Message::RequestId];
+        requests.Pop();
+        if (status != RpcStatus::Pending) {
+            respond(id, status);
+        }
+        if (unsent_.Front()) {
+            return;
+        }
+    }
+}
+
+void RpcServer::Complete(uint32_t requestId, RpcStatus status)
+{
+    respond(requestId, status);
+}
+
+void RpcServer::respond(uint32_t requestId, RpcStatus status)
+{
+    Message response;
+    response.type = Message::Type::Response;
+    response.data[Message::RequestId] = requestId;
+    response.data[Message::Argument] = static_cast<uint32_t>(status);
+    if (!unsent_.Front() && Sender::GetInstance().TrySend(response) != Sender::Result::Rejected) {
+        return;
+    }
+    // Kept in order behind the responses already waiting.
+    auto slot = unsent_.Reserve();
+    if (!slot) {
+        Logger::error() << "RPC response " << requestId << " lost, too many unsent\n";
+        return;
+    }
+    response.CopyTo(*slot);
+    unsent_.Publish();
+}
+} // namespace mini_lcd
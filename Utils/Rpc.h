@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Comm.h"
+#include "SpscRing.h"
+
+#include <array>
+#include <functional>
+
+namespace mini_lcd
+{
+// Pending is returned by a server handler that completes the request later, it is never sent.
+enum class RpcStatus : uint32_t { Ok, Failed, Unsupported, Timeout, Pending };
+
+// Core1 side of requests to core0. Requests travel in their own ring, the responses come back as
+// Response messages through the Receiver and complete the call. Nothing ever waits: a call fails
+// right away when the ring or the table of pending calls is full, and a call without a response
+// by its deadline completes with Timeout.
+class RpcClient
+{
+public:
+    using Callback = std::function<void(RpcStatus)>;
+
+    static constexpr uint32_t kDefaultTimeoutMs = 2000;
+
+    // The request id is filled in, the other fields are up to the caller.
+    bool Call(Message request, Callback done, uint32_t timeoutMs = kDefaultTimeoutMs);
+    void OnResponse(const Message& response);
+    // Completes the calls past their deadline.
+    void Poll();
+
+private:
+    struct Pending
+    {
+        uint32_t id = 0;
+        uint64_t deadline = 0;
+        Callback done;
+    };
+
+    std::array<Pending, 4> pending_;
+    uint32_t nextId_ = 1;
+};
+
+// Core0 side, polled from the network loop. The FIFO towards core0 belongs to the multicore
+// lockout of flash writes, so requests are not announced by a doorbell.
+class RpcServer
+{
+public:
+    using Handler = std::function<RpcStatus(const Message&)>;
+
+    void Handle(Message::Type type, Handler handler);
+    // Serves the queued requests and sends the responses through the Sender. Responses the
+    // Sender cannot take are kept and retried first, the requests wait in their ring meanwhile.
+    void Process();
+    // Answers a request whose handler returned Pending.
+    void Complete(uint32_t requestId, RpcStatus status);
+
+private:
+    void respond(uint32_t requestId, RpcStatus status);
+
+    std::array<Handler, static_cast<size_t>(Message::Type::Count)> handlers_;
+    SpscRing<Message, 4> unsent_;
+};
+} // namespace mini_lcd
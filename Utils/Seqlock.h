@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace mini_lcd
+{
+// Value with a single writer and any number of lock-free readers, for example on the other core.
+// The sequence is odd while a write is in progress, a reader copies the value and retries when
+// the sequence was odd or changed in the meantime. Readers never block the writer, the writer
+// never waits for readers.
+template <typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    void Write(const T& value)
+    {
+        std::array<uint32_t, kWords> words{};
+        memcpy(words.data(), &value, sizeof(T));
+        auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    T Read() const
+    {
+        std::array<uint32_t, kWords> words;
+        for (;;) {
+            auto before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;
+            }
+            for (size_t i = 0; i < kWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        T value;
+        memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + 3) / 4;
+
+    std::atomic<uint32_t> sequence_ = 0;
+    // Copied word by word with atomics, so a torn read is detected rather than undefined.
+    std::array<std::atomic<uint32_t>, kWords> words_{};
+};
+} // namespace mini_lcd
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Aggregates that a SlidingWindow maintains, memory is only reserved for the selected ones.
+enum WindowAggregate : uint8_t {
+    WindowMean = 1,
+    WindowMin = 2,
+    WindowMax = 4,
+    // Number of samples above a threshold.
+    WindowAbove = 8,
+};
+
+// Rolling aggregates over the samples of the last few seconds. Min and max are kept in monotonic
+// deques and the mean as a running sum, so every sample costs O(1) amortized however long the
+// window is. Capacity bounds the samples in the window, when it is reached the oldest sample is
+// dropped before its time is up.
+template <size_t Capacity, uint8_t Aggregates>
+class SlidingWindow
+{
+public:
+    explicit SlidingWindow(uint32_t seconds, uint16_t threshold = UINT16_MAX)
+        : seconds_(seconds)
+        , threshold_(threshold)
+    {
+    }
+
+    void Add(uint32_t seconds, uint16_t value)
+    {
+        while (first_ != next_ &&
+               (seconds - times_[first_ % Capacity] >= seconds_ || next_ - first_ == Capacity)) {
+            expire();
+        }
+
+        times_[next_ % Capacity] = seconds;
+        values_[next_ % Capacity] = value;
+        if constexpr (Aggregates & WindowMean) {
+            sum_ += value;
+        }
+        if constexpr (Aggregates & WindowMin) {
+            min_.push(values_, next_, [value](uint16_t last) { return last >= value; });
+        }
+        if constexpr (Aggregates & WindowMax) {
+            max_.push(values_, next_, [value](uint16_t last) { return last <= value; });
+        }
+        if constexpr (Aggregates & WindowAbove) {
+            above_ += value > threshold_;
+        }
+        ++next_;
+    }
+
+    size_t Size() const
+    {
+        return next_ - first_;
+    }
+
+    uint16_t Mean() const
+    {
+        static_assert(Aggregates & WindowMean);
+        return Size() ? sum_ / Size() : 0;
+    }
+
+    uint16_t Min() const
+    {
+        static_assert(Aggregates & WindowMin);
+        return Size() ? values_[min_.front() % Capacity] : 0;
+    }
+
+    uint16_t Max() const
+    {
+        static_assert(Aggregates & WindowMax);
+        return Size() ? values_[max_.front() % Capacity] : 0;
+    }
+
+    // Share of the samples above the threshold in percent.
+    uint8_t AbovePercent() const
+    {
+        static_assert(Aggregates & WindowAbove);
+        return Size() ? above_ * 100 / Size() : 0;
+    }
+
+private:
+    // Sequence numbers of the samples that can still become the extreme of the window, their
+    // values ordered from the front.
+    template <size_t N>
+    struct Deque
+    {
+        std::array<uint32_t, N> data{};
+        uint32_t head = 0;
+        uint32_t tail = 0;
+
+        // Samples dominated by the new one can never be the extreme again.
+        template <typename Dominated>
+        void push(const std::array<uint16_t, Capacity>& values, uint32_t sequence,
+            Dominated dominated)
+        {
+            while (tail != head && dominated(values[data[(tail - 1) % N] % Capacity])) {
+                --tail;
+            }
+            data[tail++ % N] = sequence;
+        }
+
+        void expire(uint32_t sequence)
+        {
+            if (tail != head && data[head % N] == sequence) {
+                ++head;
+            }
+        }
+
+        uint32_t front() const
+        {
+            return data[head % N];
+        }
+    };
+
+    void expire()
+    {
+        auto value = values_[first_ % Capacity];
+        if constexpr (Aggregates & WindowMean) {
+            sum_ -= value;
+        }
+        if constexpr (Aggregates & WindowMin) {
+            min_.expire(first_);
+        }
+        if constexpr (Aggregates & WindowMax) {
+            max_.expire(first_);
+        }
+        if constexpr (Aggregates & WindowAbove) {
+            above_ -= value > threshold_;
+        }
+        ++first_;
+    }
+
+    const uint32_t seconds_;
+    const uint16_t threshold_;
+    std::array<uint32_t, Capacity> times_{};
+    std::array<uint16_t, Capacity> values_{};
+    // Sequence numbers of the oldest sample in the window and of the next one.
+    uint32_t first_ = 0;
+    uint32_t next_ = 0;
+    uint32_t sum_ = 0;
+    uint32_t above_ = 0;
+    Deque<(Aggregates & WindowMin) ? Capacity : 0> min_;
+    Deque<(Aggregates & WindowMax) ? Capacity : 0> max_;
+};
+} // namespace mini_lcd
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mini_lcd
+{
+// Lock-free ring of slots between exactly one producer and one consumer, for example the two
+// cores. Elements are built and read in place: the producer reserves a slot, fills it and
+// publishes it, the consumer reads the front slot and pops it when done. The indices are free
+// running, the release store of one side pairs with the acquire load of the other, so a slot is
+// never touched by both at once. Write() and Read() copy whole batches with one index update.
+template <typename T, size_t N>
+class SpscRing
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    // Producer: free slot to fill, nullptr when the ring is full. Reserving again without
+    // publishing returns the same slot.
+    T* Reserve()
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == N) {
+            return nullptr;
+        }
+        return &slots_[tail % N];
+    }
+
+    // Producer: hands the reserved slot over to the consumer.
+    void Publish()
+    {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: oldest published slot, nullptr when the ring is empty.
+    T* Front()
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots_[head % N];
+    }
+
+    // Consumer: gives the front slot back to the producer.
+    void Pop()
+    {
+        head_.store(head_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Producer: copies as many values as fit and publishes them at once, returns their count.
+    size_t Write(std::span<const T> values)
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        size_t free = N - (tail - head_.load(std::memory_order_acquire));
+        size_t count = std::min(values.size(), free);
+        for (size_t i = 0; i < count; ++i) {
+            slots_[(tail + i) % N] = values[i];
+        }
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer: copies up to values.size() published values and pops them at once, returns their
+    // count.
+    size_t Read(std::span<T> values)
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        size_t available = tail_.load(std::memory_order_acquire) - head;
+        size_t count = std::min(values.size(), available);
+        for (size_t i = 0; i < count; ++i) {
+            values[i] = slots_[(head + i) % N];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Either side, exact only from one side while the other one is idle.
+    size_t Size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, N> slots_;
+    std::atomic<uint32_t> head_ = 0;
+    std::atomic<uint32_t> tail_ = 0;
+};
+} // namespace mini_lcd
@@ -1,20 +1,38 @@
 #include "TCP.h"
 #include "Comm.h"
 #include "Logger.h"
-
-#include "Utils/tiny-json.h"
+#include "Utils.h"
 
 #include "pico/stdlib.h"
 #include "pico/cyw43_arch.h"
 #include <pico/multicore.h>
 
 #include <iostream>
-#include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <charconv>
 
 namespace mini_lcd
 {
+namespace
+{
+// Referenced by lwIP until acknowledged instead of being copied into the send buffer.
+constexpr char kRequest[] = "GET /measurements HTTP/1.1\r\n"
+                            "Host: " SERVER_ADDR "\r\n"
+                            "Connection: keep-alive\r\n"
+                            "\r\n";
+// Poll callback period in units of 500 ms.
+constexpr u8_t kPollTicks = 4;
+// An unanswered request this old means the connection is dead.
+constexpr uint64_t kResponseTimeoutMs = 5000;
+} // namespace
+
 TCPTest::TCPTest()
+    : http_([this](HttpResponseParser::Event event, std::string_view data) {
+          onHttp(event, data);
+      }),
+      json_([this](JsonParser::Event event, int depth, std::string_view key,
+                std::string_view value) { onJson(event, depth, key, value); })
 {
     if (cyw43_arch_init() != 0) {
         // std::cout << "cyw43 init failed!\n";
@@ -32,7 +50,7 @@ TCPTest::~TCPTest()
 bool TCPTest::Connect()
 {
     if (cyw43_arch_wifi_connect_timeout_ms(
-            WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, 30000)) {
+            WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK, kJoinTimeoutMs)) {
         // std::cout << "failed to connect.\n";
         return false;
     }
@@ -40,36 +58,93 @@ bool TCPTest::Connect()
     return true;
 }
 
+void TCPTest::StartJoin()
+{
+    cyw43_arch_lwip_begin();
+    close(0);
+    cyw43_arch_lwip_end();
+    joinDeadline_ = Utils::millis() + kJoinTimeoutMs;
+    if (cyw43_arch_wifi_connect_async(WIFI_SSID, WIFI_PASSWORD, CYW43_AUTH_WPA2_AES_PSK)) {
+        Logger::error() << "Wi-Fi join could not start\n";
+        joinDeadline_ = 0;
+    }
+}
+
+TCPTest::Join TCPTest::PollJoin()
+{
+    auto status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    if (status == CYW43_LINK_UP) {
+        return Join::Up;
+    }
+    // Failures are negative: no network, bad credentials or a general failure.
+    if (status < 0 || Utils::millis() >= joinDeadline_) {
+        Logger::warn() << "Wi-Fi join failed, link status " << status << "\n";
+        return Join::Failed;
+    }
+    return Join::InProgress;
+}
+
 void TCPTest::GetMeasurements()
 {
-    if (reporting_) {
+    // No point in fetching what would only replace a queued snapshot.
+    if (backpressure_ && Sender::GetInstance().GetStats().depth > 0) {
+        Logger::debug() << "Core1 is behind, poll skipped\n";
         return;
     }
-    reporting_ = true;
+    cyw43_arch_lwip_begin();
+    if (inFlight_ == kMaxInFlight || requestPending_) {
+        Logger::debug() << "Previous request still pending, poll skipped\n";
+    } else if (connected_) {
+        send();
+    } else if (pcb || open()) {
+        requestPending_ = true;
+    }
+    cyw43_arch_lwip_end();
+}
+
+bool TCPTest::open()
+{
     ip4addr_aton(SERVER_ADDR, &remote_addr);
     pcb = tcp_new_ip_type(IP_GET_TYPE(&remote_addr));
     if (!pcb) {
-        // std::cout << "Failed to create pcb\n";
-        return;
+        Logger::error() << "Failed to create pcb\n";
+        return false;
     }
 
     tcp_arg(pcb, this);
 
-    tcp_poll(pcb, &TCPTest::tcp_client_poll, 20);
+    tcp_poll(pcb, &TCPTest::tcp_client_poll, kPollTicks);
     tcp_sent(pcb, &TCPTest::tcp_client_sent);
     tcp_recv(pcb, &TCPTest::tcp_client_recv);
     tcp_err(pcb, &TCPTest::tcp_client_err);
 
-    cyw43_arch_lwip_begin();
     err_t err = tcp_connect(pcb, &remote_addr, 8700, tcp_client_connected);
     Logger::debug() << "Connecting to " << ip4addr_ntoa(&remote_addr) << " result: " << (int)err << "\n";
-    cyw43_arch_lwip_end();
+    if (err != ERR_OK) {
+        close(err);
+        return false;
+    }
+    return true;
+}
+
+void TCPTest::send()
+{
+    auto res = tcp_write(pcb, kRequest, sizeof kRequest - 1, 0);
+    if (res != ERR_OK) {
+        Logger::warn() << "TCP write result: " << (int)res << "\n";
+        return;
+    }
+    sentAt_[inFlight_++] = Utils::millis();
+    tcp_output(pcb);
 }
 
 err_t TCPTest::poll(tcp_pcb* arg)
 {
-    // std::cout << "Poll\n";
-    return close(-1);
+    if (inFlight_ && Utils::millis() - sentAt_[0] > kResponseTimeoutMs) {
+        Logger::warn() << "No response from the server, closing\n";
+        return close(-1);
+    }
+    return ERR_OK;
 }
 err_t TCPTest::sent(tcp_pcb* tpcb, u16_t len)
 {
@@ -79,75 +154,151 @@ err_t TCPTest::sent(tcp_pcb* tpcb, u16_t len)
 err_t TCPTest::recv(tcp_pcb* arg, pbuf* buf, err_t err)
 {
     if (!buf) {
-        // std::cout << "TCP: Received empty buffer\n";
+        // The server closed its side, the next poll opens a new connection.
+        Logger::debug() << "Server closed the connection\n";
+        http_.Closed();
+        return close(inFlight_ ? -1 : 0);
+    }
+    Logger::debug() << "TCP received " << (int)buf->tot_len << "\n";
+    // Straight from the segment payloads, the chain is never assembled.
+    bool framed = true;
+    for (auto segment = buf; segment && framed && !http_.Closing(); segment = segment->next) {
+        framed = http_.Feed({static_cast<const char*>(segment->payload), segment->len});
+    }
+    tcp_recved(pcb, buf->tot_len);
+    pbuf_free(buf);
+    if (!framed) {
+        Logger::error() << "Malformed HTTP response, closing\n";
         return close(-1);
     }
-    Logger::debug() << "TCP received " << (int)buf->len << " " << (int)buf->tot_len << "\n";
-    Logger::trace() << std::string_view{(char*)buf->payload, buf->len} << "\n";
-    auto jsonStr = std::string((char*)buf->payload, buf->len);
-    auto jsonStartPos = jsonStr.find('{');
-    if (jsonStartPos == std::string::npos) {
-        Logger::warn() << "No JSON object found in response\n";
-        tcp_recved(pcb, buf->tot_len);
-        pbuf_free(buf);
+    if (http_.Closing()) {
+        Logger::debug() << "Server asked to close the connection\n";
         return close(0);
     }
-    jsonStr = jsonStr.substr(jsonStartPos);
-    Logger::trace() << "JSON: " << jsonStr << "\n";
-    json_t pool[128];
-    auto parent = json_create((char*)jsonStr.c_str(), pool, sizeof pool / sizeof *pool);
-    if (parent == nullptr) {
-        Logger::error() << "Failed to parse JSON\n";
-        tcp_recved(pcb, buf->tot_len);
-        pbuf_free(buf);
-        return close(0);
+    return ERR_OK;
+}
+
+void TCPTest::onHttp(HttpResponseParser::Event event, std::string_view data)
+{
+    switch (event) {
+        case HttpResponseParser::Event::Start:
+            json_.Reset();
+            inMeasurements_ = false;
+            measurementFound_ = false;
+            break;
+        case HttpResponseParser::Event::Body:
+            json_.Feed(data);
+            break;
+        case HttpResponseParser::Event::End:
+            responseDone();
+            break;
+    }
+}
+
+void TCPTest::responseDone()
+{
+    if (inFlight_) {
+        telemetry_.pollRttMs = Utils::millis() - sentAt_[0];
+        std::copy(sentAt_.begin() + 1, sentAt_.end(), sentAt_.begin());
+        --inFlight_;
     }
-    auto measurements = json_getProperty(parent, "measurements");
-    if (!measurements || json_getType(measurements) != JSON_ARRAY) {
+    if (http_.Status() != 200) {
+        Logger::warn() << "HTTP status " << http_.Status() << "\n";
+    } else if (!json_.Done()) {
+        Logger::error() << "Failed to parse JSON\n";
+    } else if (!measurementFound_) {
         Logger::warn() << "No measurements found in JSON\n";
-        tcp_recved(pcb, buf->tot_len);
-        pbuf_free(buf);
-        return close(0);
+    } else {
+        sendMeasurements();
     }
+}
 
-    Message msg;
-    msg.type = Message::Type::Measurements;
-    int idx = 0;
-
-    auto parseAndSend = [&msg, &idx](const json_t* measurement, const char* value) {
-        uint32_t val = 0;
-        auto valStr = json_getPropertyValue(measurement, value);
-        if (valStr) {
-            val = std::stoi(valStr);
+void TCPTest::onJson(
+    JsonParser::Event event, int depth, std::string_view key, std::string_view value)
+{
+    using Event = JsonParser::Event;
+    // {"measurements": [{"CPU0": 12, ..., "RAM": 40, ...}, ...]}, the last object counts.
+    if (depth == 1) {
+        inMeasurements_ = event == Event::ArrayStart && key == "measurements";
+        return;
+    }
+    if (!inMeasurements_) {
+        return;
+    }
+    if (depth == 2 && event == Event::ObjectStart) {
+        measurement_.type = Message::Type::Measurements;
+        std::fill_n(measurement_.data.begin(), Message::CoreLoads, 0);
+        coresSeen_.reset();
+        return;
+    }
+    if (depth == 2 && event == Event::ObjectEnd) {
+        // Cores are numbered from CPU0 without gaps, the first missing one ends the list.
+        int cores = 0;
+        while (cores < Message::kMaxCores && coresSeen_[cores]) {
+            ++cores;
         }
-        msg.data[idx++] = val;
-    };
-
-    for (auto measurement = json_getChild(measurements); measurement;
-        measurement = json_getSibling(measurement)) {
-        if (json_getType(measurement) == JSON_OBJ) {
-            auto time = json_getPropertyValue(measurement, "time");
-            for (int i = 0; i < 16; ++i) {
-                std::string cpuName = "CPU" + std::to_string(i);
-                parseAndSend(measurement, cpuName.c_str());
-            }
-            parseAndSend(measurement, "RAM");
-            parseAndSend(measurement, "GPU");
-            parseAndSend(measurement, "GPUVD");
-            parseAndSend(measurement, "GPUVE");
-            parseAndSend(measurement, "GPUMEM");
+        measurement_.data[Message::Cores] = cores;
+        measurementFound_ = true;
+        return;
+    }
+    if (depth != 3 || (event != Event::Number && event != Event::String)) {
+        return;
+    }
+
+    uint32_t number = 0;
+    std::from_chars(value.data(), value.data() + value.size(), number);
+    if (key.starts_with("CPU")) {
+        int core = 0;
+        auto index = key.substr(3);
+        auto [end, ec] = std::from_chars(index.data(), index.data() + index.size(), core);
+        if (ec == std::errc{} && end == index.data() + index.size() && core >= 0 &&
+            core < Message::kMaxCores) {
+            measurement_.SetCoreLoad(core, std::min<uint32_t>(number, 100));
+            coresSeen_[core] = true;
         }
+    } else if (key == "RAM") {
+        measurement_.data[Message::Ram] = number;
+    } else if (key == "GPU") {
+        measurement_.data[Message::Gpu] = number;
+    } else if (key == "GPUVD") {
+        measurement_.data[Message::GpuVd] = number;
+    } else if (key == "GPUVE") {
+        measurement_.data[Message::GpuVe] = number;
+    } else if (key == "GPUMEM") {
+        measurement_.data[Message::GpuMem] = number;
+    }
+}
+
+void TCPTest::sendMeasurements()
+{
+    ++telemetry_.measurements;
+    telemetry_.ram = measurement_.data[Message::Ram];
+    telemetry_.gpu = measurement_.data[Message::Gpu];
+    telemetry_.gpuVd = measurement_.data[Message::GpuVd];
+    telemetry_.gpuVe = measurement_.data[Message::GpuVe];
+    telemetry_.gpuMem = measurement_.data[Message::GpuMem];
+    cyw43_wifi_get_rssi(&cyw43_state, &telemetry_.rssi);
+    Telemetry::Shared().Write(telemetry_);
+
+    // Parsed into a member rather than a ring slot, the RPC responses use the ring between two
+    // segments of a response.
+    auto& sender = Sender::GetInstance();
+    auto result = sender.TrySend(measurement_);
+    backpressure_ = result != Sender::Result::Delivered;
+    if (backpressure_) {
+        auto stats = sender.GetStats();
+        Logger::warn() << "Core1 is behind, send result " << static_cast<int>(result)
+                       << ", queued " << stats.depth << ", dropped " << stats.drops
+                       << ", coalesced " << stats.coalesced << "\n";
     }
-    Sender::GetInstance().Send(msg);
 
-    tcp_recved(pcb, buf->tot_len);
-    pbuf_free(buf);
     Logger::debug() << "Measurements sent to core 1\n";
-    return close(0);
 }
 void TCPTest::error(err_t err)
 {
     Logger::error() << "TCP error " << (int)err << "\n";
+    // lwIP has already freed the pcb.
+    pcb = nullptr;
     close(-1);
 }
 err_t TCPTest::conn(tcp_pcb* arg, err_t err)
@@ -157,17 +308,27 @@ err_t TCPTest::conn(tcp_pcb* arg, err_t err)
         return close(err);
     }
 
-    std::stringstream ss;
-    ss << "GET /measurements HTTP/1.1\r\n"
-          "\r\n\r\n";
-
-    auto res = tcp_write(pcb, ss.str().data(), ss.str().size(), TCP_WRITE_FLAG_COPY);
-    Logger::debug() << "TCP write result: " << (int)res << "\n";
+    connected_ = true;
+    if (requestPending_) {
+        requestPending_ = false;
+        send();
+    }
     return ERR_OK;
 }
 
 err_t TCPTest::close(int status)
 {
+    if (status != 0) {
+        ++telemetry_.pollFailures;
+        Telemetry::Shared().Write(telemetry_);
+    }
+    connected_ = false;
+    requestPending_ = false;
+    inFlight_ = 0;
+    http_.Reset();
+    if (!pcb) {
+        return ERR_OK;
+    }
     tcp_arg(pcb, nullptr);
     tcp_poll(pcb, nullptr, 0);
     tcp_sent(pcb, nullptr);
@@ -179,7 +340,7 @@ err_t TCPTest::close(int status)
         tcp_abort(pcb);
         res = ERR_ABRT;
     }
-    reporting_ = false;
+    pcb = nullptr;
     return res;
 }
 } // namespace mini_lcd
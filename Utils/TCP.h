@@ -3,6 +3,15 @@
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
 
+#include "Comm.h"
+#include "HttpResponseParser.h"
+#include "JsonParser.h"
+#include "Telemetry.h"
+
+#include <array>
+#include <bitset>
+#include <string_view>
+
 namespace mini_lcd
 {
 class TCPTest
@@ -11,7 +20,13 @@ public:
     TCPTest();
     ~TCPTest();
 
+    // Joins the Wi-Fi network, blocks for up to 30 s.
     bool Connect();
+    // Joins the network without waiting, PollJoin() reports the outcome. The connection to the
+    // server is dropped, the next poll opens a new one.
+    void StartJoin();
+    enum class Join { InProgress, Up, Failed };
+    Join PollJoin();
 
     void GetMeasurements();
 
@@ -42,12 +57,43 @@ private:
     void error(err_t err);
     err_t conn(tcp_pcb* arg, err_t err);
 
+    bool open();
+    void send();
+    // Responses are parsed as the segments arrive, nothing is buffered but one header line.
+    void onHttp(HttpResponseParser::Event event, std::string_view data);
+    void responseDone();
+    void onJson(JsonParser::Event event, int depth, std::string_view key, std::string_view value);
+    void sendMeasurements();
+
     err_t close(int status);
 
+    // Requests pipelined on the connection before polls are skipped.
+    static constexpr int kMaxInFlight = 2;
+
+    static constexpr uint64_t kJoinTimeoutMs = 30000;
+
+    uint64_t joinDeadline_ = 0;
     ip_addr_t remote_addr;
+    // One keep-alive connection, opened on demand and reused until either side closes it.
     tcp_pcb* pcb = nullptr;
+    bool connected_ = false;
+    // A poll arrived while connecting, sent as soon as the connection is up.
+    bool requestPending_ = false;
+    // Send times of the unanswered requests, oldest first.
+    std::array<uint64_t, kMaxInFlight> sentAt_{};
+    int inFlight_ = 0;
 
-    bool reporting_ = false;
+    HttpResponseParser http_;
+    JsonParser json_;
+    bool inMeasurements_ = false;
+    bool measurementFound_ = false;
+    // Built from the body of the current response.
+    Message measurement_;
+    std::bitset<Message::kMaxCores> coresSeen_;
+    // The last measurements could not be handed over to core1 directly.
+    bool backpressure_ = false;
+    // Master copy of what core0 publishes.
+    Telemetry telemetry_;
     int co2_ = 0;
     float hum_ = 0;
     float temp_ = 0;
@@ -0,0 +1,15 @@
+#include "Telemetry.h"
+
+namespace mini_lcd
+{
+namespace
+{
+// Constant initialized, both cores may use it from their first instruction.
+constinit Seqlock<Telemetry> shared;
+} // namespace
+
+Seqlock<Telemetry>& Telemetry::Shared()
+{
+    return shared;
+}
+} // namespace mini_lcd
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Seqlock.h"
+
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Newest values published by core0. Renderers read a consistent copy whenever they draw instead
+// of receiving every update as a message.
+struct Telemetry
+{
+    // Latest measurements.
+    uint32_t measurements = 0;
+    uint32_t ram = 0;
+    uint32_t gpu = 0;
+    uint32_t gpuVd = 0;
+    uint32_t gpuVe = 0;
+    uint32_t gpuMem = 0;
+    // Network.
+    int32_t rssi = 0;
+    uint32_t pollRttMs = 0;
+    uint32_t pollFailures = 0;
+
+    static Seqlock<Telemetry>& Shared();
+};
+} // namespace mini_lcd
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mini_lcd
+{
+// Fixed size history at three resolutions: the latest raw samples, one minute buckets and one hour
+// buckets, each bucket holding min, mean and max. Samples are rolled up as they arrive, a finished
+// minute is folded into its hour, so any resolution can be drawn straight from its ring.
+template <size_t RawSize, size_t MinuteSize, size_t HourSize>
+class TimeSeries
+{
+public:
+    enum class Tier { Raw, Minute, Hour };
+
+    struct Bucket
+    {
+        uint16_t min;
+        uint16_t mean;
+        uint16_t max;
+    };
+
+    void Add(uint32_t seconds, uint16_t value)
+    {
+        raw_.push({seconds, value});
+
+        uint32_t minute = seconds / 60;
+        if (minute_.count && minute != minute_.period) {
+            closeMinute();
+        }
+        uint32_t hour = minute / 60;
+        if (hour_.count && hour != hour_.period) {
+            hours_.push(hour_.bucket());
+            hour_ = {};
+        }
+        minute_.period = minute;
+        minute_.add(value);
+    }
+
+    // Marks a stretch of unknown length without samples, for example while powered off. The
+    // open buckets are closed and both bucket tiers get a gap entry. Raw samples are drawn by
+    // age against the newest one, so the ones before the gap are dropped instead.
+    void AddGap()
+    {
+        raw_ = {};
+        if (minute_.count) {
+            closeMinute();
+        }
+        if (hour_.count) {
+            hours_.push(hour_.bucket());
+            hour_ = {};
+        }
+        minutes_.push(kGap);
+        hours_.push(kGap);
+    }
+
+    static bool IsGap(const Bucket& bucket)
+    {
+        return bucket.min > bucket.max;
+    }
+
+    // Number of entries in a tier including the bucket still being filled.
+    size_t Size(Tier tier) const
+    {
+        switch (tier) {
+            case Tier::Raw:
+                return raw_.size;
+            case Tier::Minute:
+                return minutes_.size + (minute_.count ? 1 : 0);
+            default:
+                return hours_.size + (hour_.count || minute_.count ? 1 : 0);
+        }
+    }
+
+    // Entry of a tier counting from the oldest. Raw samples have min, mean and max equal.
+    Bucket At(Tier tier, size_t index) const
+    {
+        switch (tier) {
+            case Tier::Raw: {
+                auto value = raw_.at(index).value;
+                return {value, value, value};
+            }
+            case Tier::Minute:
+                return index < minutes_.size ? minutes_.at(index) : minute_.bucket();
+            default:
+                if (index < hours_.size) {
+                    return hours_.at(index);
+                }
+                Accumulator open = hour_;
+                open.merge(minute_);
+                return open.bucket();
+        }
+    }
+
+    // Time of a raw sample in seconds.
+    uint32_t Time(size_t index) const
+    {
+        return raw_.at(index).seconds;
+    }
+
+    uint16_t Last() const
+    {
+        return raw_.size ? raw_.at(raw_.size - 1).value : 0;
+    }
+
+private:
+    static constexpr Bucket kGap = {UINT16_MAX, 0, 0};
+
+    struct Sample
+    {
+        uint32_t seconds;
+        uint16_t value;
+    };
+
+    struct Accumulator
+    {
+        uint32_t period = 0;
+        uint32_t sum = 0;
+        uint32_t count = 0;
+        uint16_t min = UINT16_MAX;
+        uint16_t max = 0;
+
+        void add(uint16_t value)
+        {
+            sum += value;
+            ++count;
+            min = std::min(min, value);
+            max = std::max(max, value);
+        }
+
+        void merge(const Accumulator& other)
+        {
+            sum += other.sum;
+            count += other.count;
+            min = std::min(min, other.min);
+            max = std::max(max, other.max);
+        }
+
+        Bucket bucket() const
+        {
+            if (!count) {
+                return {0, 0, 0};
+            }
+            return {min, static_cast<uint16_t>(sum / count), max};
+        }
+    };
+
+    template <typename T, size_t N>
+    struct Ring
+    {
+        std::array<T, N> data{};
+        size_t start = 0;
+        size_t size = 0;
+
+        void push(const T& value)
+        {
+            data[(start + size) % N] = value;
+            if (size < N) {
+                ++size;
+            } else {
+                start = (start + 1) % N;
+            }
+        }
+
+        const T& at(size_t index) const
+        {
+            return data[(start + index) % N];
+        }
+    };
+
+    void closeMinute()
+    {
+        minutes_.push(minute_.bucket());
+        uint32_t hour = minute_.period / 60;
+        if (hour_.count && hour != hour_.period) {
+            hours_.push(hour_.bucket());
+            hour_ = {};
+        }
+        hour_.period = hour;
+        hour_.merge(minute_);
+        minute_ = {};
+    }
+
+    Ring<Sample, RawSize> raw_;
+    Ring<Bucket, MinuteSize> minutes_;
+    Ring<Bucket, HourSize> hours_;
+    Accumulator minute_;
+    Accumulator hour_;
+};
+} // namespace mini_lcd
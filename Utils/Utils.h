@@ -9,5 +9,8 @@ struct Utils
     static uint64_t micros();
 
     static uint64_t millis();
+
+    // CRC-32 (IEEE), pass the previous result to continue over several buffers.
+    static uint32_t crc32(const void* data, size_t size, uint32_t crc = 0);
 };
-} // namespace mini_lcd
\ No newline at end of file
+} // namespace mini_lcd
@@ -0,0 +1,68 @@
+#include "WarmState.h"
+#include "Logger.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mini_lcd
+{
+namespace
+{
+constexpr uint32_t kMagic = 0x4D524157; // "WARM"
+
+struct Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+    uint32_t crc;
+};
+} // namespace
+
+bool WarmState::Store(
+    std::span<uint8_t> area, uint32_t version, std::span<const std::span<uint8_t>> parts)
+{
+    static_assert(sizeof(Header) == kHeaderSize);
+    Header header{kMagic, version, 0, 0};
+    for (auto part : parts) {
+        header.size += part.size();
+    }
+    if (sizeof(Header) + header.size > area.size()) {
+        Logger::error() << "Warm state of " << header.size << " bytes does not fit\n";
+        return false;
+    }
+
+    auto data = area.data() + sizeof(Header);
+    for (auto part : parts) {
+        memcpy(data, part.data(), part.size());
+        data += part.size();
+    }
+    header.crc = Utils::crc32(area.data() + sizeof(Header), header.size);
+    memcpy(area.data(), &header, sizeof(header));
+    return true;
+}
+
+bool WarmState::Load(
+    std::span<uint8_t> area, uint32_t version, std::span<const std::span<uint8_t>> parts)
+{
+    Header header;
+    memcpy(&header, area.data(), sizeof(header));
+    size_t size = 0;
+    for (auto part : parts) {
+        size += part.size();
+    }
+    if (area.size() < sizeof(Header) + size || header.magic != kMagic ||
+        header.version != version || header.size != size ||
+        header.crc != Utils::crc32(area.data() + sizeof(Header), size)) {
+        return false;
+    }
+
+    auto data = area.data() + sizeof(Header);
+    for (auto part : parts) {
+        memcpy(part.data(), data, part.size());
+        data += part.size();
+    }
+    return true;
+}
+} // namespace mini_lcd
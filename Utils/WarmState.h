@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace mini_lcd
+{
+// State handed over to the next boot in RAM that the runtime does not clear on start-up. It
+// survives a watchdog reboot but not a power cycle. Each owner declares its block with
+// __uninitialized_ram, sized by StorageSize() for its parts. Every block carries a version and a
+// CRC, a block that does not match is reported as missing and the owner starts cold.
+class WarmState
+{
+public:
+    static constexpr size_t StorageSize(size_t payload)
+    {
+        return kHeaderSize + payload;
+    }
+
+    // Copies the parts one after another into the block.
+    static bool Store(
+        std::span<uint8_t> block, uint32_t version, std::span<const std::span<uint8_t>> parts);
+    // Copies the block back into the parts, false when it is missing or of another layout.
+    static bool Load(
+        std::span<uint8_t> block, uint32_t version, std::span<const std::span<uint8_t>> parts);
+
+private:
+    static constexpr size_t kHeaderSize = 16;
+};
+} // namespace mini_lcd
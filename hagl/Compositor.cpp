@@ -0,0 +1,131 @@
+#include "Compositor.h"
+
+#include "Display.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+/* One band is composited while the other one is being sent. */
+alignas(4) hagl_color_t bands[2][Display::width * Compositor::kBandHeight];
+uint8_t band = 0;
+
+/*
+ * Overlays two pixels per word. A pixel equal to the key keeps the
+ * background, both colours are in display byte order so the halves of
+ * a word are still whole pixels.
+ */
+void blend(hagl_color_t* dst, const hagl_color_t* src, uint16_t count, hagl_color_t key)
+{
+    uint32_t* d = (uint32_t*)dst;
+    const uint32_t* s = (const uint32_t*)src;
+    uint32_t pair = ((uint32_t)key << 16) | key;
+
+    for (uint16_t i = 0; i < count / 2; ++i) {
+        uint32_t pixels = s[i];
+        uint32_t diff = pixels ^ pair;
+        if (0 == diff) {
+            continue;
+        }
+        uint32_t mask = ((diff & 0x0000ffff) ? 0x0000ffff : 0) | ((diff & 0xffff0000) ? 0xffff0000 : 0);
+        d[i] = (pixels & mask) | (d[i] & ~mask);
+    }
+}
+} // namespace
+
+Compositor::Compositor(const hagl_sprite_t* background, hagl_color_t key)
+    : background_(background)
+    , key_(key)
+{
+}
+
+hagl_color_t Compositor::key() const
+{
+    return key_;
+}
+
+void Compositor::invalidate()
+{
+    invalid_ = true;
+}
+
+void Compositor::background(uint32_t skip, uint16_t count, hagl_color_t* dst)
+{
+    while (skip) {
+        if (0 == left_) {
+            left_ = background_->runs[run_];
+            run_ += 2;
+        }
+        uint32_t step = std::min<uint32_t>(skip, left_);
+        left_ -= step;
+        skip -= step;
+    }
+    while (count) {
+        if (0 == left_) {
+            left_ = background_->runs[run_];
+            run_ += 2;
+        }
+        hagl_color_t color = background_->palette[background_->runs[run_ - 1]];
+        uint16_t step = std::min(count, left_);
+        std::fill_n(dst, step, color);
+        dst += step;
+        left_ -= step;
+        count -= step;
+    }
+}
+
+void Compositor::flush(Display& display, int16_t x0, int16_t y0, uint16_t width,
+    uint16_t height, const hagl_color_t* pixels, const hagl_window_t* dirty)
+{
+    assert(background_->width == width && background_->height == height);
+
+    hagl_window_t region;
+    if (invalid_) {
+        region = {0, 0, static_cast<uint16_t>(width - 1), static_cast<uint16_t>(height - 1)};
+    } else if (dirty && previous_set_) {
+        region = {std::min(dirty->x0, previous_.x0), std::min(dirty->y0, previous_.y0),
+            std::max(dirty->x1, previous_.x1), std::max(dirty->y1, previous_.y1)};
+    } else if (dirty) {
+        region = *dirty;
+    } else if (previous_set_) {
+        region = previous_;
+    } else {
+        return;
+    }
+
+    /* Whole words on both sides so rows can be blended two pixels at a time. */
+    region.x0 &= ~1;
+    region.x1 |= 1;
+
+    uint16_t columns = region.x1 - region.x0 + 1;
+    uint16_t skip = width - columns;
+
+    run_ = 0;
+    left_ = 0;
+    background(region.y0 * width + region.x0, 0, nullptr);
+
+    hagl_bitmap_t bitmap;
+    bool first = true;
+    uint16_t y = region.y0;
+    while (y <= region.y1) {
+        uint16_t rows = std::min<uint16_t>(kBandHeight, region.y1 - y + 1);
+        hagl_color_t* dst = bands[band];
+        for (uint16_t row = 0; row < rows; ++row) {
+            background(first ? 0 : skip, columns, dst);
+            first = false;
+            blend(dst, pixels + (y + row) * width + region.x0, columns, key_);
+            dst += columns;
+        }
+        hagl_bitmap_init(&bitmap, columns, rows, display.depth, bands[band]);
+        display.blit_async(x0 + region.x0, y0 + y, &bitmap);
+        band ^= 1;
+        y += rows;
+    }
+
+    previous_set_ = dirty != nullptr;
+    if (dirty) {
+        previous_ = *dirty;
+    }
+    invalid_ = false;
+}
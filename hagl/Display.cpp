@@ -52,6 +52,11 @@ static inline uint16_t htons(uint16_t i)
     return i;
 }
 
+/* All displays share one SPI bus, so at most one DMA write is in flight. */
+static int dma_channel = -1;
+static spi_inst_t* dma_spi = nullptr;
+static Pin dma_cs = -1;
+
 Display::Display(Pin scl, Pin sda, Pin dc, Pin cs, spi_inst_t* spi)
     : scl_(scl)
     , sda_(sda)
@@ -71,6 +76,8 @@ Display::Display(Pin scl, Pin sda, Pin dc, Pin cs, spi_inst_t* spi)
 
 void Display::write_command(const uint8_t command)
 {
+    wait_transfer();
+
     /* Set DC low to denote incoming command. */
     gpio_put(dc_, 0);
 
@@ -85,22 +92,31 @@ void Display::write_command(const uint8_t command)
 
 void Display::write_data(const uint8_t* data, size_t length)
 {
-    size_t sent = 0;
+    write_rows(data, length, 1, length);
+}
 
-    if (0 == length) {
+void Display::write_rows(const uint8_t* data, size_t length, uint16_t rows, size_t pitch)
+{
+    if (0 == length || 0 == rows) {
         return;
     };
 
+    wait_transfer();
+
     /* Set DC high to denote incoming data. */
     gpio_put(dc_, 1);
 
     /* Set CS low to reserve the SPI bus. */
     gpio_put(cs_, 0);
 
-    for (size_t i = 0; i < length; ++i) {
-        while (!spi_is_writable(spi_)) {
-        };
-        spi_get_hw(spi_)->dr = (uint32_t)data[i];
+    /* Rows are streamed back to back, the address window wraps them. */
+    for (uint16_t row = 0; row < rows; ++row) {
+        for (size_t i = 0; i < length; ++i) {
+            while (!spi_is_writable(spi_)) {
+            };
+            spi_get_hw(spi_)->dr = (uint32_t)data[i];
+        }
+        data += pitch;
     }
 
     /* Wait for shifting to finish. */
@@ -341,7 +357,8 @@ size_t Display::fill_xywh(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, void
     return size;
 }
 
-size_t Display::write_xywh(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t* buffer)
+size_t Display::write_xywh(
+    uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t* buffer, uint16_t pitch)
 {
     if (0 == w || 0 == h) {
         return 0;
@@ -350,15 +367,16 @@ size_t Display::write_xywh(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uin
     int32_t x2 = x1 + w - 1;
     int32_t y2 = y1 + h - 1;
     uint32_t size = w * h;
+    size_t row = w * MIPI_DISPLAY_DEPTH / 8;
 
 #ifdef HAGL_HAL_USE_SINGLE_BUFFER
     set_address_xyxy(x1, y1, x2, y2);
-    write_data(buffer, size * MIPI_DISPLAY_DEPTH / 8);
+    write_rows(buffer, row, h, pitch);
 #endif /* HAGL_HAL_SINGLE_BUFFER */
 
 #ifdef HAGL_HAS_HAL_BACK_BUFFER
     set_address_xyxy(x1, y1, x2, y2);
-    write_data(buffer, size * MIPI_DISPLAY_DEPTH / 8);
+    write_rows(buffer, row, h, pitch);
 #endif /* HAGL_HAS_HAL_BACK_BUFFER */
     /* This should also include the bytes for writing the commands. */
     return size * MIPI_DISPLAY_DEPTH / 8;
@@ -424,6 +442,97 @@ bool Display::Enabled() const
     return enabled_;
 }
 
+void Display::blit_async(int16_t x0, int16_t y0, hagl_bitmap_t* src)
+{
+    if (!enabled_) {
+        return;
+    }
+    if (0 == src->width || 0 == src->height) {
+        return;
+    }
+
+    /* Also waits for the previous transfer to finish. */
+    set_address_xyxy(x0, y0, x0 + src->width - 1, y0 + src->height - 1);
+
+    if (dma_channel < 0) {
+        dma_channel = dma_claim_unused_channel(true);
+    }
+
+    /* Set DC high to denote incoming data. */
+    gpio_put(dc_, 1);
+
+    /* Set CS low to reserve the SPI bus. */
+    gpio_put(cs_, 0);
+
+    dma_channel_config config = dma_channel_get_default_config(dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_dreq(&config, spi_get_dreq(spi_, true));
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    dma_channel_configure(dma_channel, &config, &spi_get_hw(spi_)->dr, src->buffer,
+        src->width * src->height * MIPI_DISPLAY_DEPTH / 8, true);
+
+    dma_spi = spi_;
+    dma_cs = cs_;
+}
+
+void Display::wait_transfer()
+{
+    if (nullptr == dma_spi) {
+        return;
+    }
+
+    dma_channel_wait_for_finish_blocking(dma_channel);
+
+    /* Wait for shifting to finish. */
+    while (spi_get_hw(dma_spi)->sr & SPI_SSPSR_BSY_BITS) {
+    };
+    spi_get_hw(dma_spi)->icr = SPI_SSPICR_RORIC_BITS;
+
+    /* Set CS high to ignore any traffic on SPI bus. */
+    gpio_put(dma_cs, 1);
+
+    dma_spi = nullptr;
+}
+
+void Display::sprite(int16_t x0, int16_t y0, const hagl_sprite_t* sprite)
+{
+    if (!enabled_) {
+        return;
+    }
+
+    set_address_xyxy(x0, y0, x0 + sprite->width - 1, y0 + sprite->height - 1);
+
+    /* Set DC high to denote incoming data. */
+    gpio_put(dc_, 1);
+
+    /* Set CS low to reserve the SPI bus. */
+    gpio_put(cs_, 0);
+
+    /* TODO: This assumes 16 bit colors. */
+    spi_set_format(spi_, 16, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+    for (uint16_t i = 0; i < sprite->size; i += 2) {
+        uint8_t count = sprite->runs[i];
+        uint32_t color = htons(sprite->palette[sprite->runs[i + 1]]);
+        while (count--) {
+            while (!spi_is_writable(spi_)) {
+            };
+            spi_get_hw(spi_)->dr = color;
+        }
+    }
+
+    /* Wait for shifting to finish. */
+    while (spi_get_hw(spi_)->sr & SPI_SSPSR_BSY_BITS) {
+    };
+    spi_get_hw(spi_)->icr = SPI_SSPICR_RORIC_BITS;
+
+    spi_set_format(spi_, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+    /* Set CS high to ignore any traffic on SPI bus. */
+    gpio_put(cs_, 1);
+}
+
 void Display::put_pixel(int16_t x0, int16_t y0, hagl_color_t color)
 {
     if (!enabled_) {
@@ -453,7 +562,7 @@ void Display::blit(int16_t x0, int16_t y0, hagl_bitmap_t* src)
     if (!enabled_) {
         return;
     }
-    write_xywh(x0, y0, src->width, src->height, (uint8_t*)src->buffer);
+    write_xywh(x0, y0, src->width, src->height, (uint8_t*)src->buffer, src->pitch);
 }
 
 uint8_t Display::putChar(wchar_t code, int16_t x0, int16_t y0, const unsigned char* font,
@@ -0,0 +1,115 @@
+#include "ShapeCache.h"
+
+#include "Display.h"
+#include "hagl.h"
+
+#include <algorithm>
+
+namespace
+{
+void rasterize(const ShapeCache::Shape shape, uint8_t width, uint8_t height, uint8_t radius,
+    hagl_color_t color, hagl_color_t bgColor, hagl_color_t* pixels)
+{
+    hagl::SpriteCanvas<ShapeCache::kSlotSize, ShapeCache::kSlotSize> canvas;
+    switch (shape) {
+        case ShapeCache::Shape::RoundedRectangle:
+            canvas.fill_rounded_rectangle(0, 0, width - 1, height - 1, radius, 1);
+            break;
+        case ShapeCache::Shape::Circle:
+            canvas.fill_circle(radius, radius, radius, 1);
+            break;
+    }
+    for (uint16_t y = 0; y < height; ++y) {
+        for (uint16_t x = 0; x < width; ++x) {
+            *(pixels++) = canvas.pixels[y * canvas.width + x] ? color : bgColor;
+        }
+    }
+}
+} // namespace
+
+void ShapeCache::rounded_rectangle(Display& display, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1, int16_t r, hagl_color_t color, hagl_color_t bgColor)
+{
+    if (x0 > x1) {
+        std::swap(x0, x1);
+    }
+    if (y0 > y1) {
+        std::swap(y0, y1);
+    }
+    int16_t width = x1 - x0 + 1;
+    int16_t height = y1 - y0 + 1;
+    if (width > kSlotSize || height > kSlotSize) {
+        ++stats_.bypassed;
+        display.rounded_rectangle(x0, y0, x1, y1, r, color, true);
+        return;
+    }
+    /* Same clamp as the primitive, so all too large radii share one entry. */
+    r = std::min<int16_t>(r, std::min(width / 2, height / 2));
+    draw(display, x0, y0,
+        {Shape::RoundedRectangle, static_cast<uint8_t>(width), static_cast<uint8_t>(height),
+            static_cast<uint8_t>(r), color, bgColor});
+}
+
+void ShapeCache::circle(
+    Display& display, int16_t x0, int16_t y0, int16_t r, hagl_color_t color, hagl_color_t bgColor)
+{
+    int16_t size = 2 * r + 1;
+    if (r < 0 || size > kSlotSize) {
+        ++stats_.bypassed;
+        display.circle(x0, y0, r, color, true);
+        return;
+    }
+    draw(display, x0 - r, y0 - r,
+        {Shape::Circle, static_cast<uint8_t>(size), static_cast<uint8_t>(size),
+            static_cast<uint8_t>(r), color, bgColor});
+}
+
+const ShapeCache::Stats& ShapeCache::stats() const
+{
+    return stats_;
+}
+
+void ShapeCache::clear()
+{
+    for (auto& slot : slots_) {
+        slot.valid = false;
+    }
+}
+
+ShapeCache::Slot& ShapeCache::lookup(const Key& key)
+{
+    Slot* victim = &slots_[0];
+    for (auto& slot : slots_) {
+        if (slot.valid && slot.key == key) {
+            ++stats_.hits;
+            slot.used = ++clock_;
+            return slot;
+        }
+        /* Prefer free slots, then the least recently used one. */
+        if (victim->valid && (!slot.valid || slot.used < victim->used)) {
+            victim = &slot;
+        }
+    }
+
+    ++stats_.misses;
+    if (victim->valid) {
+        ++stats_.evictions;
+    }
+    victim->key = key;
+    victim->valid = true;
+    victim->used = ++clock_;
+    rasterize(key.shape, key.width, key.height, key.radius, key.color, key.bgColor,
+        victim->pixels.data());
+    return *victim;
+}
+
+void ShapeCache::draw(Display& display, int16_t x0, int16_t y0, const Key& key)
+{
+    if (!display.Enabled()) {
+        return;
+    }
+    Slot& slot = lookup(key);
+    hagl_bitmap_t bitmap;
+    hagl_bitmap_init(&bitmap, key.width, key.height, display.depth, slot.pixels.data());
+    hagl_blit(display, x0, y0, &bitmap);
+}
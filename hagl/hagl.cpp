@@ -48,19 +48,6 @@ SPDX-License-Identifier: MIT
 
 #include "hagl.h"
 #include "hagl_hal.h"
-#include "Display.h"
-
-void hagl_clear(Display& display)
-{
-    uint16_t x0 = display.clip.x0;
-    uint16_t y0 = display.clip.y0;
-    uint16_t x1 = display.clip.x1;
-    uint16_t y1 = display.clip.y1;
-
-    hagl_set_clip(display, 0, 0, display.width - 1, display.height - 1);
-    hagl_fill_rectangle(display, 0, 0, display.width - 1, display.height - 1, 0x00);
-    hagl_set_clip(display, x0, y0, x1, y1);
-}
 
 void hagl_init(
     hagl_backend_t* backend, uint8_t scl, uint8_t sda, uint8_t dc, uint8_t cs, spi_inst_t* spi)
@@ -39,9 +39,6 @@ SPDX-License-Identifier: MIT
 
 #include "hagl/bitmap.h"
 
-#include <stdio.h>
-#include "hagl_hal.h"
-
 static void put_pixel(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, hagl_color_t color)
 {
     hagl_color_t* ptr =
@@ -54,22 +51,30 @@ static hagl_color_t get_pixel(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0)
     return *(hagl_color_t*)(bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0);
 }
 
-void hline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+static void hline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
 {
     hagl_color_t* ptr =
         (hagl_color_t*)(bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0);
-    for (uint16_t x = 0; x < width; x++) {
-        *ptr++ = color;
-    }
+    hagl_bitmap_fill(ptr, width, color);
 }
 
-void vline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+static void vline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
 {
     hagl_color_t* ptr =
         (hagl_color_t*)(bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0);
-    for (uint16_t y = 0; y < height; y++) {
+    uint16_t stride = bitmap->pitch / sizeof(hagl_color_t);
+
+    while (height >= 4) {
+        ptr[0] = color;
+        ptr[stride] = color;
+        ptr[stride * 2] = color;
+        ptr[stride * 3] = color;
+        ptr += stride * 4;
+        height -= 4;
+    }
+    while (height--) {
         *ptr = color;
-        ptr += bitmap->pitch / (bitmap->depth / 8);
+        ptr += stride;
     }
 }
 
@@ -85,7 +90,7 @@ static void blit(hagl_bitmap_t* dst, int16_t x0, int16_t y0, hagl_bitmap_t* src)
     int16_t y1 = 0;
 
     /* x0 or y0 is over the edge, nothing to do. */
-    if ((x0 > dst->width) || (y0 > dst->height)) {
+    if ((x0 >= dst->width) || (y0 >= dst->height)) {
         return;
     }
 
@@ -114,22 +119,27 @@ static void blit(hagl_bitmap_t* dst, int16_t x0, int16_t y0, hagl_bitmap_t* src)
     }
 
     /* Everthing outside viewport, nothing to do. */
-    if ((srcw < 0) || (srch < 0)) {
+    if ((srcw <= 0) || (srch <= 0)) {
         return;
     }
 
-    uint8_t* dstptr = (uint8_t*)(dst->buffer + (dst->pitch * y0) + ((dst->depth / 8) * x0));
-    uint8_t* srcptr = (uint8_t*)(src->buffer + (src->pitch * y1) + ((dst->depth / 8) * x1));
-
     /* Bytes per pixel. */
     uint8_t bytes = dst->depth / 8;
+    size_t row = srcw * bytes;
+
+    uint8_t* dstptr = dst->buffer + (dst->pitch * y0) + (bytes * x0);
+    uint8_t* srcptr = src->buffer + (src->pitch * y1) + (bytes * x1);
+
+    /* Rows are contiguous in both bitmaps, copy everything at once. */
+    if (row == dst->pitch && row == src->pitch) {
+        memcpy(dstptr, srcptr, row * srch);
+        return;
+    }
+
     for (uint16_t y = 0; y < srch; y++) {
-        for (uint16_t x = 0; x < srcw; x++) {
-            for (uint16_t z = 0; z < bytes; z++) {
-                *(dstptr++) = *(srcptr++);
-            }
-        }
-        dstptr += (dst->pitch / (dst->depth / 8) - srcw) * bytes;
+        memcpy(dstptr, srcptr, row);
+        dstptr += dst->pitch;
+        srcptr += src->pitch;
     }
 }
 
@@ -137,75 +147,89 @@ static void blit(hagl_bitmap_t* dst, int16_t x0, int16_t y0, hagl_bitmap_t* src)
  * Blit source bitmap to target bitmap scaling it up or down to given
  * dimensions.
  *
+ * Source coordinates are stepped in 16.16 fixed point. The source row
+ * pointer is computed once per destination row and x is advanced by
+ * adding the ratio, so there are no multiplications in the inner loop.
+ *
  * http://www.tech-algorithm.com/articles/nearest-neighbor-image-scaling
  * http://www.davdata.nl/math/bmresize.html
  */
 
+template <typename T>
+static void scale_rows(hagl_bitmap_t* dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth,
+    hagl_bitmap_t* src, uint32_t fx0, uint32_t fy0, uint32_t x_ratio, uint32_t y_ratio)
+{
+    uint8_t* dstrow = dst->buffer + dst->pitch * y0 + sizeof(T) * x0;
+    uint32_t fy = fy0;
+
+    for (uint16_t y = 0; y < dsth; y++) {
+        const T* srcrow = (const T*)(src->buffer + src->pitch * (fy >> 16));
+        T* dstptr = (T*)dstrow;
+        uint32_t fx = fx0;
+
+        for (uint16_t x = 0; x < dstw; x++) {
+            *(dstptr++) = srcrow[fx >> 16];
+            fx += x_ratio;
+        }
+
+        dstrow += dst->pitch;
+        fy += y_ratio;
+    }
+}
+
 static void scale_blit(
     hagl_bitmap_t* dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth, hagl_bitmap_t* src)
 {
-    uint16_t px, py;
+    if (0 == dstw || 0 == dsth) {
+        return;
+    }
 
-    uint16_t srcw = src->width;
-    uint16_t srch = src->height;
-    uint32_t x_ratio = (uint32_t)((srcw << 16) / dstw);
-    uint32_t y_ratio = (uint32_t)((srch << 16) / dsth);
+    uint32_t x_ratio = (uint32_t)(((uint32_t)src->width << 16) / dstw);
+    uint32_t y_ratio = (uint32_t)(((uint32_t)src->height << 16) / dsth);
+    int32_t w = dstw;
+    int32_t h = dsth;
+    uint32_t fx0 = 0;
+    uint32_t fy0 = 0;
 
     /* x0 or y0 is over the edge, nothing to do. */
-    if ((x0 > dst->width) || (y0 > dst->height)) {
+    if ((x0 >= dst->width) || (y0 >= dst->height)) {
         return;
     }
 
-    /* x0 is negative, ignore parts outside of screen. */
+    /* x0 is negative, skip source columns which end up outside. */
     if (x0 < 0) {
-        dstw = dstw + x0;
+        w = w + x0;
+        fx0 = (uint32_t)(-x0) * x_ratio;
         x0 = 0;
     }
 
-    /* y0 is negative, ignore parts outside of screen. */
+    /* y0 is negative, skip source rows which end up outside. */
     if (y0 < 0) {
-        dsth = dsth + y0;
+        h = h + y0;
+        fy0 = (uint32_t)(-y0) * y_ratio;
         y0 = 0;
     }
 
     /* Ignore everything going over right edge. */
-    if (dstw > (dst->width - x0)) {
-        dstw = dst->width - x0;
+    if (w > (dst->width - x0)) {
+        w = dst->width - x0;
     }
 
     /* Ignore everything going over bottom edge. */
-    if (dsth > (dst->height - y0)) {
-        dsth = dst->height - y0;
+    if (h > (dst->height - y0)) {
+        h = dst->height - y0;
     }
 
-    /* Bytes per pixel. */
-    uint8_t bytes = dst->depth / 8;
+    if ((w <= 0) || (h <= 0)) {
+        return;
+    }
 
-    /* If sentence here is not the most elegant thing, but makes */
-    /* the pointer maths much more easy to read. */
-    if (2 == bytes) {
-        uint16_t* dstptr = (uint16_t*)(dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0);
-        uint16_t* srcptr = (uint16_t*)src->buffer;
-        for (uint16_t y = 0; y < dsth; y++) {
-            for (uint16_t x = 0; x < dstw; x++) {
-                px = ((x * x_ratio) >> 16);
-                py = ((y * y_ratio) >> 16);
-                *(dstptr++) = srcptr[(uint8_t)((py * srcw) + px)];
-            }
-            dstptr += dst->pitch / (dst->depth / 8) - dstw;
-        }
+    /* Bytes per pixel. */
+    if (2 == dst->depth / 8) {
+        scale_rows<uint16_t>(dst, x0, y0, w, h, src, fx0, fy0, x_ratio, y_ratio);
     } else {
         /* Assume 1 byte per pixel. */
-        uint8_t* dstptr = (uint8_t*)(dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0);
-        uint8_t* srcptr = (uint8_t*)src->buffer;
-        for (uint16_t y = 0; y < dsth; y++) {
-            for (uint16_t x = 0; x < dstw; x++) {
-                px = ((x * x_ratio) >> 16);
-                py = ((y * y_ratio) >> 16);
-                *(dstptr++) = srcptr[(uint8_t)((py * srcw) + px)];
-            }
-            dstptr += dst->pitch / (dst->depth / 8) - dstw;
-        }
+        scale_rows<uint8_t>(dst, x0, y0, w, h, src, fx0, fy0, x_ratio, y_ratio);
     }
 }
 
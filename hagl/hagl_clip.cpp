@@ -37,9 +37,8 @@ https://en.wikipedia.org/wiki/Cohen%E2%80%93Sutherland_algorithm
 #include <stdint.h>
 #include <stdbool.h>
 
-#include "hagl/backend.h"
+#include "hagl/clip.h"
 #include "hagl/window.h"
-#include "Display.h"
 
 static const uint8_t INSIDE = 0b0000;
 static const uint8_t LEFT = 0b0001;
@@ -122,11 +121,4 @@ bool hagl_clip_line(int16_t* x0, int16_t* y0, int16_t* x1, int16_t* y1, hagl_win
     return accept;
 }
 
-void hagl_set_clip(Display& display, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
-{
-    display.clip.x0 = x0;
-    display.clip.y0 = y0;
-    display.clip.x1 = x1;
-    display.clip.y1 = y1;
-}
 
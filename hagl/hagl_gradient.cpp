@@ -0,0 +1,41 @@
+/*
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#include <stdint.h>
+
+#include "hagl/gradient.h"
+#include "hsl.h"
+#include "rgb565.h"
+
+void
+hagl_gradient_hsl(hagl_gradient_t *gradient, uint8_t h0, uint8_t h1, uint8_t s, uint8_t l)
+{
+    int32_t span = h1 - h0;
+
+    for (uint16_t i = 0; i < HAGL_GRADIENT_STOPS; i++) {
+        uint8_t h = h0 + span * i / (HAGL_GRADIENT_STOPS - 1);
+        gradient->stops[i] = hsl_to_rgb565(h, s, l);
+    }
+}
+
+void
+hagl_gradient_rgb(hagl_gradient_t *gradient, rgb_t from, rgb_t to)
+{
+    int32_t dr = to.r - from.r;
+    int32_t dg = to.g - from.g;
+    int32_t db = to.b - from.b;
+
+    for (uint16_t i = 0; i < HAGL_GRADIENT_STOPS; i++) {
+        gradient->stops[i] = rgb565(
+            from.r + dr * i / (HAGL_GRADIENT_STOPS - 1),
+            from.g + dg * i / (HAGL_GRADIENT_STOPS - 1),
+            from.b + db * i / (HAGL_GRADIENT_STOPS - 1)
+        );
+    }
+}
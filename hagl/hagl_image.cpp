@@ -36,87 +36,31 @@ SPDX-License-Identifier: MIT
 #include <stdio.h>
 
 #include "hagl/image.h"
-#include "hagl/backend.h"
 #include "hagl.h"
-#include "tjpgd.h"
 #include "Display.h"
 
-struct tjpgd_iodev_t
+static uint16_t file_reader(void* context, uint8_t* buffer, uint16_t size)
 {
-    tjpgd_iodev_t(Display& display) : display(display) {}
-    FILE* fp;
-    int16_t x0;
-    int16_t y0;
-    Display& display;
-};
-
-static uint16_t tjpgd_data_reader(JDEC* decoder, uint8_t* buffer, uint16_t size)
-{
-    tjpgd_iodev_t* device = (tjpgd_iodev_t*)decoder->device;
+    FILE* fp = (FILE*)context;
 
     if (buffer) {
         /* Read bytes from input stream. */
-        return (uint16_t)fread(buffer, 1, size, device->fp);
+        return (uint16_t)fread(buffer, 1, size, fp);
     } else {
         /* Skip bytes from input stream. */
-        return fseek(device->fp, size, SEEK_CUR) ? 0 : size;
+        return fseek(fp, size, SEEK_CUR) ? 0 : size;
     }
 }
 
-static uint16_t tjpgd_data_writer(JDEC* decoder, void* bitmap, JRECT* rectangle)
-{
-    tjpgd_iodev_t* device = (tjpgd_iodev_t*)decoder->device;
-    uint8_t width = (rectangle->right - rectangle->left) + 1;
-    uint8_t height = (rectangle->bottom - rectangle->top) + 1;
-
-    hagl_bitmap_t block = {
-        .width = width,
-        .height = height,
-        .depth = device->display.depth,
-        .clip = {0, 0, 0, 0},
-        .put_pixel = nullptr,
-        .get_pixel = nullptr,
-        .color = 0,
-        .blit = nullptr,
-        .scale_blit = nullptr,
-        .hline = nullptr,
-        .vline = nullptr,
-        .pitch = (uint16_t)(width * (device->display.depth / 8)),
-        .size = (uint16_t)(width * (device->display.depth / 8) * height),
-        .buffer = (uint8_t*)bitmap,
-    };
-
-    hagl_blit(device->display, rectangle->left + device->x0, rectangle->top + device->y0, &block);
-
-    return 1;
-}
-
 uint32_t hagl_load_image(Display& display, int16_t x0, int16_t y0, const char* filename)
 {
-    uint8_t work[3100];
-    JDEC decoder;
-    JRESULT result;
-    tjpgd_iodev_t device(display);
+    FILE* fp = fopen(filename, "rb");
 
-    device.x0 = x0;
-    device.y0 = y0;
-    device.fp = fopen(filename, "rb");
-
-    if (!device.fp) {
+    if (!fp) {
         return HAGL_ERR_FILE_IO;
     }
-    result = jd_prepare(&decoder, tjpgd_data_reader, work, 3100, (void*)&device);
-    if (result == JDR_OK) {
-        result = jd_decomp(&decoder, tjpgd_data_writer, 0);
-        if (JDR_OK != result) {
-            fclose(device.fp);
-            return HAGL_ERR_TJPGD + result;
-        }
-    } else {
-        fclose(device.fp);
-        return HAGL_ERR_TJPGD + result;
-    }
 
-    fclose(device.fp);
-    return HAGL_OK;
+    uint32_t result = hagl_load_image_reader(display, x0, y0, file_reader, fp);
+    fclose(fp);
+    return result;
 }
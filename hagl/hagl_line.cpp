@@ -1,84 +0,0 @@
-/*
-
-MIT License
-
-Copyright (c) 2018-2023 Mika Tuupola
-
-Permission is hereby granted, free of charge, to any person obtaining a copy
-of this software and associated documentation files (the "Software"), to deal
-in the Software without restriction, including without limitation the rights
-to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-copies of the Software, and to permit persons to whom the Software is
-furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-
--cut-
-
-This file is part of the HAGL graphics library:
-https://github.com/tuupola/hagl
-
-
-SPDX-License-Identifier: MIT
-
-*/
-
-#include <stdbool.h>
-
-#include "hagl/color.h"
-#include "hagl/backend.h"
-#include "hagl/line.h"
-#include "hagl/clip.h"
-#include "hagl.h"
-#include "Display.h"
-
-void hagl_draw_line(
-    Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
-{
-    /* Clip coordinates to fit clip window. */
-    if (false == hagl_clip_line(&x0, &y0, &x1, &y1, display.clip)) {
-        return;
-    }
-
-    int16_t dx;
-    int16_t sx;
-    int16_t dy;
-    int16_t sy;
-    int16_t err;
-    int16_t e2;
-
-    dx = ABS(x1 - x0);
-    sx = x0 < x1 ? 1 : -1;
-    dy = ABS(y1 - y0);
-    sy = y0 < y1 ? 1 : -1;
-    err = (dx > dy ? dx : -dy) / 2;
-
-    while (1) {
-        hagl_put_pixel(display, x0, y0, color);
-
-        if (x0 == x1 && y0 == y1) {
-            break;
-        };
-
-        e2 = err + err;
-
-        if (e2 > -dx) {
-            err -= dy;
-            x0 += sx;
-        }
-
-        if (e2 < dy) {
-            err += dx;
-            y0 += sy;
-        }
-    }
-}
@@ -1,117 +0,0 @@
-/*
-
-MIT License
-
-Copyright (c) 2018-2023 Mika Tuupola
-
-Permission is hereby granted, free of charge, to any person obtaining a copy
-of this software and associated documentation files (the "Software"), to deal
-in the Software without restriction, including without limitation the rights
-to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
-copies of the Software, and to permit persons to whom the Software is
-furnished to do so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-
--cut-
-
-This file is part of the HAGL graphics library:
-https://github.com/tuupola/hagl
-
-
-SPDX-License-Identifier: MIT
-
-*/
-
-#include <stdint.h>
-
-#include "hagl/color.h"
-#include "hagl/backend.h"
-#include "hagl/line.h"
-#include "hagl/hline.h"
-#include "Display.h"
-
-void hagl_draw_polygon(Display& display, int16_t amount, int16_t* vertices, hagl_color_t color)
-{
-    for (int16_t i = 0; i < amount - 1; i++) {
-        hagl_draw_line(display, vertices[(i << 1) + 0], vertices[(i << 1) + 1],
-            vertices[(i << 1) + 2], vertices[(i << 1) + 3], color);
-    }
-    hagl_draw_line(display, vertices[0], vertices[1], vertices[(amount << 1) - 2],
-        vertices[(amount << 1) - 1], color);
-}
-
-/* Adapted from  http://alienryderflex.com/polygon_fill/ */
-void hagl_fill_polygon(
-    Display& display, int16_t amount, int16_t* vertices, hagl_color_t color)
-{
-    uint16_t nodes[64];
-    int16_t y;
-
-    float x0;
-    float y0;
-    float x1;
-    float y1;
-
-    int16_t miny = display.height;
-    int16_t maxy = 0;
-
-    for (uint8_t i = 0; i < amount; i++) {
-        if (miny > vertices[(i << 1) + 1]) {
-            miny = vertices[(i << 1) + 1];
-        }
-        if (maxy < vertices[(i << 1) + 1]) {
-            maxy = vertices[(i << 1) + 1];
-        }
-    }
-
-    /*  Loop through the rows of the image. */
-    for (y = miny; y < maxy; y++) {
-        /*  Build a list of nodes. */
-        int16_t count = 0;
-        int16_t j = amount - 1;
-
-        for (int16_t i = 0; i < amount; i++) {
-            x0 = vertices[(i << 1) + 0];
-            y0 = vertices[(i << 1) + 1];
-            x1 = vertices[(j << 1) + 0];
-            y1 = vertices[(j << 1) + 1];
-
-            if ((y0 < (float)y && y1 >= (float)y) || (y1 < (float)y && y0 >= (float)y)) {
-                nodes[count] = (int16_t)(x0 + (y - y0) / (y1 - y0) * (x1 - x0));
-                count++;
-            }
-            j = i;
-        }
-
-        /* Sort the nodes, via a simple “Bubble” sort. */
-        int16_t i = 0;
-        while (i < count - 1) {
-            if (nodes[i] > nodes[i + 1]) {
-                int16_t swap = nodes[i];
-                nodes[i] = nodes[i + 1];
-                nodes[i + 1] = swap;
-                if (i) {
-                    i--;
-                }
-            } else {
-                i++;
-            }
-        }
-
-        /* Draw lines between nodes. */
-        for (int16_t i = 0; i < count; i += 2) {
-            int16_t width = nodes[i + 1] - nodes[i];
-            hagl_draw_hline(display, nodes[i], y, width, color);
-        }
-    }
-}
@@ -39,6 +39,7 @@ SPDX-License-Identifier: BSD-2-Clause
 #include <stdint.h>
 
 #include "hsl.h"
+#include "rgb565.h"
 
 rgb_t
 hsl_to_rgb888(hsl_t *hsl)
@@ -111,3 +112,51 @@ hsl_to_rgb888(hsl_t *hsl)
 
     return rgb;
 }
+
+/*
+ * Hue is scaled by three so that one sextant of the color wheel is
+ * exactly 128 units. Whole circle is 768 units.
+ */
+static inline uint8_t
+hsl_channel(int32_t temp1, int32_t temp2, int32_t hue)
+{
+    int32_t value;
+
+    if (hue < 128) {
+        value = temp1 + (((temp2 - temp1) * hue) >> 7);
+    } else if (hue < 384) {
+        value = temp2;
+    } else if (hue < 512) {
+        value = temp1 + (((temp2 - temp1) * (512 - hue)) >> 7);
+    } else {
+        value = temp1;
+    }
+
+    return (uint8_t)((value * 255) >> 8);
+}
+
+hagl_color_t
+hsl_to_rgb565(uint8_t h, uint8_t s, uint8_t l)
+{
+    int32_t temp1, temp2, hue;
+
+    /* Saturation 0 means shade of grey. */
+    if (0 == s) {
+        uint8_t grey = (uint8_t)((l * 255) >> 8);
+        return rgb565(grey, grey, grey);
+    }
+
+    if (l < 128) {
+        temp2 = (l * (256 + s)) >> 8;
+    } else {
+        temp2 = l + s - ((l * s) >> 8);
+    }
+    temp1 = 2 * l - temp2;
+    hue = h * 3;
+
+    return rgb565(
+        hsl_channel(temp1, temp2, (hue + 256) % 768),
+        hsl_channel(temp1, temp2, hue),
+        hsl_channel(temp1, temp2, (hue + 512) % 768)
+    );
+}
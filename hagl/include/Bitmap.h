@@ -0,0 +1,82 @@
+#pragma once
+
+#include "hagl_hal.h"
+#include "hagl_hal_color.h"
+#include "hagl/bitmap.h"
+#include "hagl/window.h"
+
+#include <cstdint>
+#include <cstring>
+
+// Fixed size RGB565 buffer in RAM that satisfies hagl::Surface, so the templated primitives draw
+// into it with the raw operations inlined. bitmap() exposes the pixels as a hagl_bitmap_t for
+// blitting onto a display or another surface.
+template <uint16_t W, uint16_t H>
+class Bitmap
+{
+public:
+    static constexpr int16_t width = W;
+    static constexpr int16_t height = H;
+    static constexpr uint8_t depth = MIPI_DISPLAY_DEPTH;
+    hagl_window_t clip{0, 0, W - 1, H - 1};
+
+    void put_pixel(int16_t x0, int16_t y0, hagl_color_t color)
+    {
+        pixels_[y0 * W + x0] = color;
+    }
+
+    void drawHlineInner(int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+    {
+        hagl_bitmap_fill(&pixels_[y0 * W + x0], width, color);
+    }
+
+    void drawVlineInner(int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+    {
+        hagl_color_t* ptr = &pixels_[y0 * W + x0];
+        for (uint16_t y = 0; y < height; ++y) {
+            *ptr = color;
+            ptr += W;
+        }
+    }
+
+    void blit(int16_t x0, int16_t y0, hagl_bitmap_t* src)
+    {
+        // Whole rows in both, one copy.
+        if (x0 == 0 && src->width == W && src->pitch == W * sizeof(hagl_color_t)) {
+            std::memcpy(&pixels_[y0 * W], src->buffer, src->pitch * src->height);
+            return;
+        }
+        const uint8_t* row = src->buffer;
+        for (uint16_t y = 0; y < src->height; ++y) {
+            std::memcpy(&pixels_[(y0 + y) * W + x0], row, src->width * sizeof(hagl_color_t));
+            row += src->pitch;
+        }
+    }
+
+    hagl_bitmap_t bitmap()
+    {
+        hagl_bitmap_t bitmap;
+        hagl_bitmap_init(&bitmap, W, H, depth, pixels_);
+        return bitmap;
+    }
+
+    void fill(hagl_color_t color)
+    {
+        for (uint16_t y = 0; y < H; ++y) {
+            hagl_bitmap_fill(&pixels_[y * W], W, color);
+        }
+    }
+
+    hagl_color_t* data()
+    {
+        return pixels_;
+    }
+
+    const hagl_color_t* data() const
+    {
+        return pixels_;
+    }
+
+private:
+    alignas(4) hagl_color_t pixels_[W * H]{};
+};
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "hagl_hal_color.h"
+#include "hagl/gradient.h"
+#include "hagl/rectangle.h"
+#include "hagl/surface.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// Column oriented charts which sweep across their area like an oscilloscope. Appending a sample
+// draws one column at the cursor and blanks the column after it, so an update costs two columns
+// no matter how much history is on screen. Values are percentages, 0...100.
+class Chart
+{
+public:
+    Chart(int16_t x0, int16_t y0, int16_t width, int16_t height, uint8_t columnWidth,
+        hagl_color_t background)
+        : x0_(x0)
+        , y0_(y0)
+        , width_(width)
+        , height_(height)
+        , columnWidth_(columnWidth)
+        , background_(background)
+    {
+    }
+
+    uint16_t columns() const
+    {
+        return width_ / columnWidth_;
+    }
+
+    // Restarts the sweep at the left edge, the area is not cleared.
+    void reset()
+    {
+        cursor_ = 0;
+    }
+
+protected:
+    // Returns the left edge of the column at the cursor and moves the cursor on.
+    template <hagl::Surface S>
+    int16_t advance(S& display)
+    {
+        int16_t x = x0_ + cursor_ * columnWidth_;
+        cursor_ = (cursor_ + 1) % columns();
+        // Gap ahead of the sweep separates the newest column from the oldest.
+        fill(display, x0_ + cursor_ * columnWidth_, y0_, y0_ + height_ - 1, background_);
+        return x;
+    }
+
+    template <hagl::Surface S>
+    void fill(S& display, int16_t x, int16_t top, int16_t bottom, hagl_color_t color)
+    {
+        if (top <= bottom) {
+            hagl_fill_rectangle_xyxy(display, x, top, x + columnWidth_ - 1, bottom, color);
+        }
+    }
+
+    int16_t level(uint8_t percent) const
+    {
+        return y0_ + height_ - 1 - std::min<uint8_t>(percent, 100) * (height_ - 1) / 100;
+    }
+
+    int16_t x0_;
+    int16_t y0_;
+    int16_t width_;
+    int16_t height_;
+    uint8_t columnWidth_;
+    hagl_color_t background_;
+    uint16_t cursor_ = 0;
+};
+
+// One row of cells per series, coloured through a gradient.
+class Heatmap : public Chart
+{
+public:
+    Heatmap(int16_t x0, int16_t y0, int16_t width, int16_t height, uint8_t columnWidth,
+        uint8_t rows, const hagl_gradient_t* gradient, hagl_color_t background)
+        : Chart(x0, y0, width, height, columnWidth, background)
+        , rows_(rows)
+        , gradient_(gradient)
+    {
+    }
+
+    // Takes one value per row, top row first.
+    template <hagl::Surface S>
+    void append(S& display, const uint8_t* values)
+    {
+        int16_t x = advance(display);
+        int16_t cell = height_ / rows_;
+        for (uint8_t row = 0; row < rows_; ++row) {
+            int16_t top = y0_ + row * cell;
+            fill(display, x, top, top + cell - 1, hagl_gradient_color(gradient_, values[row]));
+        }
+    }
+
+    // Leaves a column empty, for a stretch without samples.
+    template <hagl::Surface S>
+    void gap(S& display)
+    {
+        int16_t x = advance(display);
+        fill(display, x, y0_, y0_ + height_ - 1, background_);
+    }
+
+private:
+    uint8_t rows_;
+    const hagl_gradient_t* gradient_;
+};
+
+// Envelope between the minimum and the maximum with the median marked.
+class Band : public Chart
+{
+public:
+    Band(int16_t x0, int16_t y0, int16_t width, int16_t height, uint8_t columnWidth,
+        hagl_color_t color, hagl_color_t medianColor, hagl_color_t background)
+        : Chart(x0, y0, width, height, columnWidth, background)
+        , color_(color)
+        , medianColor_(medianColor)
+    {
+    }
+
+    template <hagl::Surface S>
+    void append(S& display, uint8_t min, uint8_t median, uint8_t max)
+    {
+        int16_t x = advance(display);
+        int16_t top = level(max);
+        int16_t bottom = level(min);
+        int16_t middle = level(median);
+        fill(display, x, y0_, top - 1, background_);
+        fill(display, x, top, middle - 1, color_);
+        fill(display, x, middle, middle, medianColor_);
+        fill(display, x, middle + 1, bottom, color_);
+        fill(display, x, bottom + 1, y0_ + height_ - 1, background_);
+    }
+
+private:
+    hagl_color_t color_;
+    hagl_color_t medianColor_;
+};
+
+// Single series line, each column joins the previous value to the new one.
+class Sparkline : public Chart
+{
+public:
+    Sparkline(int16_t x0, int16_t y0, int16_t width, int16_t height, uint8_t columnWidth,
+        hagl_color_t color, hagl_color_t background)
+        : Chart(x0, y0, width, height, columnWidth, background)
+        , color_(color)
+    {
+    }
+
+    template <hagl::Surface S>
+    void append(S& display, uint8_t value)
+    {
+        int16_t x = advance(display);
+        int16_t current = level(value);
+        int16_t previous = cursor_ == 1 ? current : level(previous_);
+        int16_t top = std::min(current, previous);
+        int16_t bottom = std::max(current, previous);
+        fill(display, x, y0_, top - 1, background_);
+        fill(display, x, top, bottom, color_);
+        fill(display, x, bottom + 1, y0_ + height_ - 1, background_);
+        previous_ = value;
+    }
+
+private:
+    hagl_color_t color_;
+    uint8_t previous_ = 0;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "hagl_hal_color.h"
+#include "hagl/sprite.h"
+#include "hagl/window.h"
+#include "Layer.h"
+
+#include <cstdint>
+
+class Display;
+
+// Composites a dynamic layer over a static background and streams the result to a display.
+// The background is a sprite of the same size as the layer, rendered once at build time. Layer
+// pixels equal to the colour key show the background. A flush only sends the union of the
+// current dirty region and the one sent last time, so content that disappeared is restored.
+class Compositor
+{
+public:
+    static constexpr uint16_t kBandHeight = 8;
+
+    Compositor(const hagl_sprite_t* background, hagl_color_t key);
+
+    hagl_color_t key() const;
+
+    // Forces the next flush to cover the whole layer, e.g. after the display was cleared.
+    void invalidate();
+
+    template <uint16_t W, uint16_t H>
+    void flush(Display& display, Layer<W, H>& layer)
+    {
+        static_assert(W % 2 == 0, "rows are blended two pixels at a time");
+        flush(display, layer.x0(), layer.y0(), W, H, layer.row(0),
+            layer.dirty() ? &layer.dirty_region() : nullptr);
+        layer.clean();
+    }
+
+private:
+    // Layer pixels are rows of width pixels, dirty is null when nothing was drawn.
+    void flush(Display& display, int16_t x0, int16_t y0, uint16_t width, uint16_t height,
+        const hagl_color_t* pixels, const hagl_window_t* dirty);
+    void background(uint32_t skip, uint16_t count, hagl_color_t* dst);
+
+    const hagl_sprite_t* background_;
+    hagl_color_t key_;
+    hagl_window_t previous_{};
+    bool previous_set_ = false;
+    bool invalid_ = true;
+
+    /* Background run cursor. */
+    uint16_t run_ = 0;
+    uint16_t left_ = 0;
+};
@@ -3,6 +3,7 @@
 #include "hagl_hal_color.h"
 #include "hagl/window.h"
 #include "hagl/bitmap.h"
+#include "hagl/sprite.h"
 #include "hagl_hal.h"
 
 #include <hardware/spi.h>
@@ -30,6 +31,12 @@ public:
     void drawVlineInner(int16_t x0, int16_t y0, uint16_t height, hagl_color_t color);
 
     void blit(int16_t x0, int16_t y0, hagl_bitmap_t* src);
+    // Starts a DMA write of a contiguous bitmap and returns. The buffer must stay untouched until
+    // wait_transfer() returns; any other SPI access on any display waits for it implicitly.
+    void blit_async(int16_t x0, int16_t y0, hagl_bitmap_t* src);
+    static void wait_transfer();
+    // Decodes the sprite runs straight into the SPI FIFO, one address window, no clipping.
+    void sprite(int16_t x0, int16_t y0, const hagl_sprite_t* sprite);
 
     void set_clip(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
 
@@ -57,12 +64,15 @@ public:
 private:
     void write_command(const uint8_t command);
     void write_data(const uint8_t* data, size_t length);
+    // Streams rows of length bytes which start pitch bytes apart, with CS held low throughout.
+    void write_rows(const uint8_t* data, size_t length, uint16_t rows, size_t pitch);
     void read_data(uint8_t* data, size_t length);
     void set_address_xyxy(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
     void set_address_xy(uint16_t x1, uint16_t y1);
     void spi_master_init();
     size_t fill_xywh(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, void* _color);
-    size_t write_xywh(uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t* buffer);
+    size_t write_xywh(
+        uint16_t x1, uint16_t y1, uint16_t w, uint16_t h, uint8_t* buffer, uint16_t pitch);
     size_t write_xy(uint16_t x1, uint16_t y1, uint8_t* buffer);
 
     /* TODO: This most likely does not work with dma atm. */
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "hagl_hal_color.h"
+#include "hagl/arc.h"
+#include "hagl/surface.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// Ring gauge drawn with hagl_fill_arc. The value is kept as the angle it was last drawn at, so an
+// update only fills the wedge between the old and the new angle: in the fill colour when the
+// value grows and in the track colour when it shrinks.
+class Gauge
+{
+public:
+    Gauge(int16_t xc, int16_t yc, int16_t r0, int16_t r1, int16_t start, int16_t sweep,
+        hagl_color_t color, hagl_color_t track)
+        : xc_(xc)
+        , yc_(yc)
+        , r0_(r0)
+        , r1_(r1)
+        , start_(start)
+        , sweep_(sweep)
+        , color_(color)
+        , track_(track)
+    {
+    }
+
+    // Makes the next draw paint the whole ring, e.g. after the display was cleared.
+    void invalidate()
+    {
+        drawn_ = false;
+    }
+
+    template <hagl::Surface S>
+    void draw(S& display, uint8_t percent)
+    {
+        int16_t angle = start_ + sweep_ * std::min<uint8_t>(percent, 100) / 100;
+        if (!drawn_) {
+            hagl_fill_arc(display, xc_, yc_, r0_, r1_, start_, angle, color_);
+            hagl_fill_arc(display, xc_, yc_, r0_, r1_, angle, start_ + sweep_, track_);
+            drawn_ = true;
+        } else if (angle > angle_) {
+            hagl_fill_arc(display, xc_, yc_, r0_, r1_, angle_, angle, color_);
+        } else if (angle < angle_) {
+            hagl_fill_arc(display, xc_, yc_, r0_, r1_, angle, angle_, track_);
+        }
+        angle_ = angle;
+    }
+
+private:
+    int16_t xc_;
+    int16_t yc_;
+    int16_t r0_;
+    int16_t r1_;
+    int16_t start_;
+    int16_t sweep_;
+    hagl_color_t color_;
+    hagl_color_t track_;
+    int16_t angle_ = 0;
+    bool drawn_ = false;
+};
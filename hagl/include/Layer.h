@@ -0,0 +1,122 @@
+#pragma once
+
+#include "hagl_hal.h"
+#include "hagl_hal_color.h"
+#include "hagl/bitmap.h"
+#include "hagl/window.h"
+#include "Bitmap.h"
+
+#include <algorithm>
+#include <cstdint>
+
+// Offscreen RGB565 layer of W x H pixels placed at a fixed position on the screen. It is a
+// hagl::Surface in screen coordinates whose raw operations are inlined into the templated
+// primitives, they only shift the coordinates and draw into a Bitmap. The clip window starts as
+// the area of the layer. Drawing grows the dirty region, which is kept in layer coordinates.
+template <uint16_t W, uint16_t H>
+class Layer
+{
+public:
+    static constexpr int16_t width = W;
+    static constexpr int16_t height = H;
+    static constexpr uint8_t depth = MIPI_DISPLAY_DEPTH;
+    hagl_window_t clip;
+
+    Layer(int16_t x0, int16_t y0)
+        : clip{static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+              static_cast<uint16_t>(x0 + W - 1), static_cast<uint16_t>(y0 + H - 1)}
+        , x0_(x0)
+        , y0_(y0)
+    {
+    }
+
+    int16_t x0() const
+    {
+        return x0_;
+    }
+
+    int16_t y0() const
+    {
+        return y0_;
+    }
+
+    const hagl_color_t* row(uint16_t y) const
+    {
+        return pixels_.data() + y * W;
+    }
+
+    // Fills the whole layer without marking it dirty, normally with the colour key.
+    void clear(hagl_color_t color)
+    {
+        pixels_.fill(color);
+    }
+
+    bool dirty() const
+    {
+        return dirty_set_;
+    }
+
+    const hagl_window_t& dirty_region() const
+    {
+        return dirty_;
+    }
+
+    void clean()
+    {
+        dirty_set_ = false;
+    }
+
+    // Raw operations, arguments are in screen coordinates and already clipped.
+    void put_pixel(int16_t x0, int16_t y0, hagl_color_t color)
+    {
+        x0 -= x0_;
+        y0 -= y0_;
+        pixels_.put_pixel(x0, y0, color);
+        touch(x0, y0, x0, y0);
+    }
+
+    void drawHlineInner(int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+    {
+        x0 -= x0_;
+        y0 -= y0_;
+        pixels_.drawHlineInner(x0, y0, width, color);
+        touch(x0, y0, x0 + width - 1, y0);
+    }
+
+    void drawVlineInner(int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+    {
+        x0 -= x0_;
+        y0 -= y0_;
+        pixels_.drawVlineInner(x0, y0, height, color);
+        touch(x0, y0, x0, y0 + height - 1);
+    }
+
+    void blit(int16_t x0, int16_t y0, hagl_bitmap_t* src)
+    {
+        x0 -= x0_;
+        y0 -= y0_;
+        pixels_.blit(x0, y0, src);
+        touch(x0, y0, x0 + src->width - 1, y0 + src->height - 1);
+    }
+
+private:
+    void touch(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+    {
+        if (!dirty_set_) {
+            dirty_ = {static_cast<uint16_t>(x0), static_cast<uint16_t>(y0),
+                static_cast<uint16_t>(x1), static_cast<uint16_t>(y1)};
+            dirty_set_ = true;
+            return;
+        }
+        dirty_.x0 = std::min<uint16_t>(dirty_.x0, x0);
+        dirty_.y0 = std::min<uint16_t>(dirty_.y0, y0);
+        dirty_.x1 = std::max<uint16_t>(dirty_.x1, x1);
+        dirty_.y1 = std::max<uint16_t>(dirty_.y1, y1);
+    }
+
+    Bitmap<W, H> pixels_;
+    hagl_window_t dirty_{};
+    int16_t x0_ = 0;
+    int16_t y0_ = 0;
+    bool dirty_set_ = false;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "hagl_hal_color.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+class Display;
+
+// Small LRU cache of rasterised filled primitives. A shape is drawn into an RGB565 bitmap the
+// first time it is requested and blitted as a single window afterwards. Shapes bigger than a slot
+// are drawn directly.
+//
+// Unlike the primitives the result is not transparent: the pixels of the bounding box outside of
+// the shape, such as rounded corners, are painted with bgColor. A single window has no way to
+// skip pixels, so callers pass the colour the area already has.
+class ShapeCache
+{
+public:
+    enum class Shape : uint8_t { RoundedRectangle, Circle };
+
+    struct Stats
+    {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t evictions = 0;
+        uint32_t bypassed = 0;
+    };
+
+    static constexpr uint16_t kSlotSize = 16;
+    static constexpr size_t kSlots = 10;
+    static constexpr size_t kBudget = kSlots * kSlotSize * kSlotSize * sizeof(hagl_color_t);
+
+    void rounded_rectangle(Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+        int16_t r, hagl_color_t color, hagl_color_t bgColor);
+    void circle(
+        Display& display, int16_t x0, int16_t y0, int16_t r, hagl_color_t color, hagl_color_t bgColor);
+
+    const Stats& stats() const;
+    void clear();
+
+private:
+    struct Key
+    {
+        Shape shape;
+        uint8_t width;
+        uint8_t height;
+        uint8_t radius;
+        hagl_color_t color;
+        hagl_color_t bgColor;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct Slot
+    {
+        Key key{};
+        uint32_t used = 0;
+        bool valid = false;
+        std::array<hagl_color_t, kSlotSize * kSlotSize> pixels{};
+    };
+
+    Slot& lookup(const Key& key);
+    void draw(Display& display, int16_t x0, int16_t y0, const Key& key);
+
+    std::array<Slot, kSlots> slots_{};
+    uint32_t clock_ = 0;
+    Stats stats_{};
+};
@@ -49,21 +49,19 @@ SPDX-License-Identifier: MIT
 #include "hagl/rectangle.h"
 #include "hagl/circle.h"
 #include "hagl/ellipse.h"
+#include "hagl/arc.h"
 #include "hagl/polygon.h"
 #include "hagl/triangle.h"
 #include "hagl/image.h"
 #include "hagl/blit.h"
 #include "hagl/char.h"
+#include "hagl/gradient.h"
+#include "hagl/sprite.h"
 
 #include <hardware/spi.h>
 
 #define ABS(x) ((x) > 0 ? (x) : -(x))
 
-/* If you want to use bigger fonts than 6x9 you need to define this. */
-#ifndef HAGL_CHAR_BUFFER_SIZE
-#define HAGL_CHAR_BUFFER_SIZE (6 * 9 * 2)
-#endif
-
 #define HAGL_OK (0)
 #define HAGL_ERR_GENERAL (1)
 #define HAGL_ERR_FILE_IO (2)
@@ -72,8 +70,17 @@ void hagl_init(hagl_backend_t* backend, uint8_t scl, uint8_t sda, uint8_t dc, ui
 size_t hagl_flush(hagl_backend_t* backend);
 void hagl_close(hagl_backend_t* backend);
 
-class Display;
-void hagl_clear(Display& display);
-void hagl_clear(Display& display);
+template <hagl::Surface S>
+void hagl_clear(S& display)
+{
+    uint16_t x0 = display.clip.x0;
+    uint16_t y0 = display.clip.y0;
+    uint16_t x1 = display.clip.x1;
+    uint16_t y1 = display.clip.y1;
+
+    hagl_set_clip(display, 0, 0, display.width - 1, display.height - 1);
+    hagl_fill_rectangle(display, 0, 0, display.width - 1, display.height - 1, 0x00);
+    hagl_set_clip(display, x0, y0, x1, y1);
+}
 
 #endif /* _HAGL_H */
@@ -0,0 +1,276 @@
+/*
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef _HAGL_ARC_H
+#define _HAGL_ARC_H
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/hline.h"
+#include "hagl/pixel.h"
+
+/* Sine of 0...90 degrees in Q14. */
+static const int16_t arc_sin[91] = {
+    0, 286, 572, 857, 1143, 1428, 1713, 1997, 2280, 2563,
+    2845, 3126, 3406, 3686, 3964, 4240, 4516, 4790, 5063, 5334,
+    5604, 5872, 6138, 6402, 6664, 6924, 7182, 7438, 7692, 7943,
+    8192, 8438, 8682, 8923, 9162, 9397, 9630, 9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384,
+};
+
+/* Maximum number of spans a single row of an arc can produce. */
+#define HAGL_ARC_MAX_SPANS (8)
+
+typedef struct {
+    int16_t x0;
+    int16_t x1;
+} hagl_arc_span_t;
+
+/*
+ * Direction of an angle in degrees as a Q14 vector. Screen y grows
+ * downwards, so growing angles turn clockwise.
+ */
+static inline void arc_direction(int32_t angle, int32_t* x, int32_t* y)
+{
+    angle %= 360;
+    if (angle < 0) {
+        angle += 360;
+    }
+    int32_t s = arc_sin[angle % 90];
+    int32_t c = arc_sin[90 - angle % 90];
+
+    switch (angle / 90) {
+        case 0:
+            *x = c;
+            *y = s;
+            break;
+        case 1:
+            *x = -s;
+            *y = c;
+            break;
+        case 2:
+            *x = -c;
+            *y = -s;
+            break;
+        default:
+            *x = s;
+            *y = -c;
+            break;
+    }
+}
+
+static inline int32_t arc_floor_div(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0))) {
+        q--;
+    }
+    return q;
+}
+
+static inline int32_t arc_ceil_div(int32_t a, int32_t b)
+{
+    return -arc_floor_div(-a, b);
+}
+
+/*
+ * Columns of row dy inside the sector which starts at direction 0
+ * (inclusive) and ends at direction 1 (exclusive), at most 90 degrees
+ * apart. Each edge is a half-plane through the centre. Within one row
+ * the cross product with the edge is linear in dx, so every edge cuts
+ * the row at a single column found with one division.
+ */
+static inline bool arc_sector_row(
+    int32_t dy, int32_t x0, int32_t y0, int32_t x1, int32_t y1, int16_t* lo, int16_t* hi)
+{
+    /* Start edge: y0 * dx <= x0 * dy. */
+    if (y0 > 0) {
+        *hi = std::min<int32_t>(*hi, arc_floor_div(x0 * dy, y0));
+    } else if (y0 < 0) {
+        *lo = std::max<int32_t>(*lo, arc_ceil_div(x0 * dy, y0));
+    } else if (x0 * dy < 0) {
+        return false;
+    }
+
+    /* End edge: y1 * dx > x1 * dy, strict so adjacent arcs do not overlap. */
+    if (y1 > 0) {
+        *lo = std::max<int32_t>(*lo, arc_floor_div(x1 * dy, y1) + 1);
+    } else if (y1 < 0) {
+        *hi = std::min<int32_t>(*hi, arc_ceil_div(x1 * dy, y1) - 1);
+    } else if (x1 * dy >= 0) {
+        return false;
+    }
+
+    return *lo <= *hi;
+}
+
+/*
+ * Collect the spans of one row, merge touching ones and draw them.
+ * xo is the outermost column of the ring on this row, xi the outermost
+ * column of the hole or -1 when the row does not cross the hole.
+ */
+template <hagl::Surface S>
+void arc_draw_row(S& display, int16_t xc, int16_t y, int16_t dy, int16_t xo, int16_t xi,
+    uint8_t sectors, const int32_t* vx, const int32_t* vy, hagl_color_t color)
+{
+    if ((y < display.clip.y0) || (y > display.clip.y1)) {
+        return;
+    }
+
+    hagl_arc_span_t radial[2];
+    uint8_t radials = 0;
+    if (xi < 0) {
+        radial[radials++] = {(int16_t)-xo, xo};
+    } else if (xi < xo) {
+        radial[radials++] = {(int16_t)-xo, (int16_t)(-xi - 1)};
+        radial[radials++] = {(int16_t)(xi + 1), xo};
+    }
+
+    hagl_arc_span_t spans[HAGL_ARC_MAX_SPANS];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < sectors; i++) {
+        for (uint8_t j = 0; j < radials; j++) {
+            int16_t lo = radial[j].x0;
+            int16_t hi = radial[j].x1;
+            if (arc_sector_row(dy, vx[i], vy[i], vx[i + 1], vy[i + 1], &lo, &hi)) {
+                /* Insertion sort by start column. */
+                uint8_t k = count++;
+                while (k > 0 && spans[k - 1].x0 > lo) {
+                    spans[k] = spans[k - 1];
+                    k--;
+                }
+                spans[k] = {lo, hi};
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        int16_t x0 = spans[i].x0;
+        int16_t x1 = spans[i].x1;
+        while (i + 1 < count && spans[i + 1].x0 <= x1 + 1) {
+            i++;
+            x1 = std::max(x1, spans[i].x1);
+        }
+        hagl_draw_hline_xyw(display, xc + x0, y, x1 - x0 + 1, color);
+    }
+}
+
+/**
+ * Draw a filled arc
+ *
+ * Fills the part of the ring between radius r0 and r1 (both inclusive)
+ * which lies between angles a0 (inclusive) and a1 (exclusive). Angles
+ * are in degrees, 0 points right and angles grow clockwise. Arcs that
+ * share an edge angle do not overlap, so a gauge can be updated by
+ * filling only the wedge between its old and new value.
+ *
+ * The angle test is done with integer cross products once per row and
+ * sector edge, output is horizontal spans. Output will be clipped to
+ * the current clip window.
+ *
+ * @param display
+ * @param xc
+ * @param yc
+ * @param r0 inner radius, 0 for a pie
+ * @param r1 outer radius
+ * @param a0 start angle in degrees
+ * @param a1 end angle in degrees, at most a0 + 360
+ * @param color
+ */
+template <hagl::Surface S>
+void hagl_fill_arc(S& display, int16_t xc, int16_t yc, int16_t r0, int16_t r1, int16_t a0,
+    int16_t a1, hagl_color_t color)
+{
+    r0 = std::max<int16_t>(r0, 0);
+    if ((r1 < 0) || (r0 > r1) || (a1 <= a0)) {
+        return;
+    }
+
+    /* Split into sectors of at most 90 degrees, each is one interval per row. */
+    int16_t sweep = std::min(a1 - a0, 360);
+    uint8_t sectors = (sweep + 89) / 90;
+    int32_t vx[5];
+    int32_t vy[5];
+    for (uint8_t i = 0; i <= sectors; i++) {
+        arc_direction(a0 + std::min<int16_t>(i * 90, sweep), &vx[i], &vy[i]);
+    }
+
+    int32_t outer = r1 * r1;
+    int32_t inner = r0 * r0;
+    int16_t xo = r1;
+    int16_t xi = r0;
+
+    for (int16_t dy = 0; dy <= r1; dy++) {
+        while (xo * xo + dy * dy > outer) {
+            xo--;
+        }
+        while (xi >= 0 && xi * xi + dy * dy >= inner) {
+            xi--;
+        }
+        arc_draw_row(display, xc, yc + dy, dy, xo, xi, sectors, vx, vy, color);
+        if (dy) {
+            arc_draw_row(display, xc, yc - dy, -dy, xo, xi, sectors, vx, vy, color);
+        }
+    }
+
+    /* The centre is on every edge, give it to pies. */
+    if (0 == r0) {
+        hagl_put_pixel(display, xc, yc, color);
+    }
+}
+
+/**
+ * Draw a filled pie slice
+ *
+ * Output will be clipped to the current clip window.
+ *
+ * @param display
+ * @param xc
+ * @param yc
+ * @param r
+ * @param a0 start angle in degrees
+ * @param a1 end angle in degrees
+ * @param color
+ */
+template <hagl::Surface S>
+inline void hagl_fill_pie(
+    S& display, int16_t xc, int16_t yc, int16_t r, int16_t a0, int16_t a1, hagl_color_t color)
+{
+    hagl_fill_arc(display, xc, yc, 0, r, a0, a1, color);
+}
+
+/**
+ * Draw a filled ring
+ *
+ * Output will be clipped to the current clip window.
+ *
+ * @param display
+ * @param xc
+ * @param yc
+ * @param r0 inner radius
+ * @param r1 outer radius
+ * @param color
+ */
+template <hagl::Surface S>
+inline void hagl_fill_ring(
+    S& display, int16_t xc, int16_t yc, int16_t r0, int16_t r1, hagl_color_t color)
+{
+    hagl_fill_arc(display, xc, yc, r0, r1, 0, 360, color);
+}
+
+#endif /* _HAGL_ARC_H */
@@ -68,5 +68,39 @@ struct hagl_bitmap_t {
 void
 hagl_bitmap_init(hagl_bitmap_t *bitmap, int16_t width, uint16_t height, uint8_t depth, void *buffer);
 
+/*
+ * Fill a run of pixels. After aligning to a word boundary the bulk is
+ * written two pixels at a time, unrolled by four words.
+ */
+static inline void
+hagl_bitmap_fill(hagl_color_t *ptr, uint16_t width, hagl_color_t color)
+{
+    if (width && ((uintptr_t)ptr & 2)) {
+        *ptr++ = color;
+        width--;
+    }
+
+    uint32_t pair = ((uint32_t)color << 16) | color;
+    uint32_t *wptr = (uint32_t *)ptr;
+    uint16_t pairs = width / 2;
+
+    while (pairs >= 4) {
+        wptr[0] = pair;
+        wptr[1] = pair;
+        wptr[2] = pair;
+        wptr[3] = pair;
+        wptr += 4;
+        pairs -= 4;
+    }
+    while (pairs--) {
+        *wptr++ = pair;
+    }
+
+    /* Odd pixel left over. */
+    if (width & 1) {
+        *(hagl_color_t *)wptr = color;
+    }
+}
+
 
 #endif /* _BITMAP_H */
\ No newline at end of file
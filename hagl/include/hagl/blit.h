@@ -38,22 +38,58 @@ SPDX-License-Identifier: MIT
 
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 
 #include "hagl/bitmap.h"
+#include "hagl/surface.h"
+#include "hagl/pixel.h"
+
+#if PICO_ON_DEVICE
+#include <hardware/interp.h>
+#endif /* PICO_ON_DEVICE */
 
+/* Number of output rows scaled blits buffer before writing them out. */
+#ifndef HAGL_BLIT_BAND_HEIGHT
+#define HAGL_BLIT_BAND_HEIGHT (8)
+#endif
 
 
 /**
  * Blit a bitmap to a display
  *
- * Output will be clipped to the current clip window.
+ * Output will be clipped to the current clip window. Only the visible
+ * part of the source is sent, as a view into the source bitmap which
+ * keeps the source pitch, so it still goes out as one address window.
  *
  * @param display
  * @param x0
  * @param y0
  * @param source pointer to a bitmap
  */
-void hagl_blit_xy(Display& display, int16_t x0, int16_t y0, hagl_bitmap_t* source);
+template <hagl::Surface S>
+void hagl_blit_xy(S& display, int16_t x0, int16_t y0, hagl_bitmap_t* source)
+{
+    /* Visible part of the bitmap, clip window edges are inclusive. */
+    int32_t vx0 = std::max<int32_t>(x0, display.clip.x0);
+    int32_t vy0 = std::max<int32_t>(y0, display.clip.y0);
+    int32_t vx1 = std::min<int32_t>(x0 + source->width - 1, display.clip.x1);
+    int32_t vy1 = std::min<int32_t>(y0 + source->height - 1, display.clip.y1);
+
+    if ((vx1 < vx0) || (vy1 < vy0)) {
+        return;
+    }
+
+    /* Same as the source when it is fully inside the clip window. */
+    uint8_t bytes = source->depth / 8;
+    hagl_bitmap_t visible = *source;
+    visible.width = vx1 - vx0 + 1;
+    visible.height = vy1 - vy0 + 1;
+    visible.size = visible.pitch * visible.height;
+    visible.buffer = source->buffer + source->pitch * (vy0 - y0) + bytes * (vx0 - x0);
+    display.blit(vx0, vy0, &visible);
+}
 
 /**
  * Blit a bitmap to a display
@@ -65,15 +101,44 @@ void hagl_blit_xy(Display& display, int16_t x0, int16_t y0, hagl_bitmap_t* sourc
  * @param y0
  * @param source pointer to a bitmap
  */
-static inline void hagl_blit(Display& display, int16_t x0, int16_t y0, hagl_bitmap_t* source)
+template <hagl::Surface S>
+inline void hagl_blit(S& display, int16_t x0, int16_t y0, hagl_bitmap_t* source)
 {
     hagl_blit_xy(display, x0, y0, source);
 }
 
+/*
+ * Produce one row of a scaled blit. Source x is stepped in 16.16 fixed
+ * point. On the RP2040 the interpolator does the accumulate, shift, mask
+ * and add to the row address in hardware, one pop per output pixel.
+ */
+static inline void scale_row(
+    hagl_color_t* dst, const hagl_color_t* src, uint32_t fx, uint32_t x_ratio, uint16_t w)
+{
+#if PICO_ON_DEVICE
+    interp0->accum[0] = fx;
+    interp0->base[0] = x_ratio;
+    interp0->base[2] = (uintptr_t)src;
+    for (uint16_t x = 0; x < w; x++) {
+        *(dst++) = *(hagl_color_t*)interp0->pop[2];
+    }
+#else
+    for (uint16_t x = 0; x < w; x++) {
+        *(dst++) = src[fx >> 16];
+        fx += x_ratio;
+    }
+#endif /* PICO_ON_DEVICE */
+}
+
 /**
  * Blit and scale a bitmap to a display
  *
- * Output will be clipped to the current clip window.
+ * Output will be clipped to the current clip window. Rows are built
+ * into a line buffer and written out in bands, so the display sees
+ * one address window per HAGL_BLIT_BAND_HEIGHT rows. On RP2040 source
+ * addresses are produced by the interp0 unit of the calling core.
+ * The band holds S::width pixels per row, so the surface width must
+ * be a compile time constant.
  *
  * @param display
  * @param x0
@@ -82,8 +147,87 @@ static inline void hagl_blit(Display& display, int16_t x0, int16_t y0, hagl_bitm
  * @param h target height
  * @param source pointer to a bitmap
  */
+template <hagl::Surface S>
 void hagl_blit_xywh(
-    Display& display, uint16_t x0, uint16_t y0, uint16_t w, uint16_t h, hagl_bitmap_t* source);
+    S& display, uint16_t x0, uint16_t y0, uint16_t w, uint16_t h, hagl_bitmap_t* source)
+{
+    static hagl_color_t band[S::width * HAGL_BLIT_BAND_HEIGHT];
+
+    if (0 == w || 0 == h) {
+        return;
+    }
+
+    uint32_t x_ratio = (uint32_t)(((uint32_t)source->width << 16) / w);
+    uint32_t y_ratio = (uint32_t)(((uint32_t)source->height << 16) / h);
+
+    /* Visible part of the destination rectangle. */
+    int32_t vx0 = std::max<int32_t>(x0, display.clip.x0);
+    int32_t vy0 = std::max<int32_t>(y0, display.clip.y0);
+    int32_t vx1 = std::min<int32_t>(x0 + w - 1, display.clip.x1);
+    int32_t vy1 = std::min<int32_t>(y0 + h - 1, display.clip.y1);
+
+    if ((vx1 < vx0) || (vy1 < vy0)) {
+        return;
+    }
+
+    uint16_t vw = vx1 - vx0 + 1;
+    uint32_t fx0 = (vx0 - x0) * x_ratio;
+    uint32_t fy = (vy0 - y0) * y_ratio;
+
+#if PICO_ON_DEVICE
+    interp_hw_save_t saved;
+    interp_save(interp0, &saved);
+
+    /* Lane 0 accumulates x, result 2 is row address + 2 * (x >> 16). */
+    interp_config config = interp_default_config();
+    interp_config_set_add_raw(&config, true);
+    interp_config_set_shift(&config, 16 - 1);
+    interp_config_set_mask(&config, 1, 16);
+    interp_set_config(interp0, 0, &config);
+
+    /* Lane 1 is unused and must add nothing. */
+    config = interp_default_config();
+    interp_set_config(interp0, 1, &config);
+    interp0->accum[1] = 0;
+    interp0->base[1] = 0;
+#endif /* PICO_ON_DEVICE */
+
+    hagl_bitmap_t bitmap;
+    uint32_t previous = UINT32_MAX;
+    int32_t y = vy0;
+
+    while (y <= vy1) {
+        uint16_t rows = std::min<int32_t>(HAGL_BLIT_BAND_HEIGHT, vy1 - y + 1);
+        hagl_color_t* dst = band;
+
+        for (uint16_t row = 0; row < rows; row++) {
+            uint32_t py = fy >> 16;
+            if (py == previous) {
+                /* Upscaling repeats source rows, reuse the previous output row. */
+                memcpy(dst, dst - vw, vw * sizeof(hagl_color_t));
+            } else {
+                const hagl_color_t* src =
+                    (const hagl_color_t*)(source->buffer + source->pitch * py);
+                scale_row(dst, src, fx0, x_ratio, vw);
+                previous = py;
+            }
+            dst += vw;
+            fy += y_ratio;
+        }
+
+        /* Whole band goes out as one address window. */
+        hagl_bitmap_init(&bitmap, vw, rows, display.depth, band);
+        display.blit(vx0, y, &bitmap);
+
+        /* First row of the next band can not reference this band. */
+        previous = UINT32_MAX;
+        y += rows;
+    }
+
+#if PICO_ON_DEVICE
+    interp_restore(interp0, &saved);
+#endif /* PICO_ON_DEVICE */
+}
 
 /**
  * Blit and scale a bitmap to a display
@@ -97,8 +241,9 @@ void hagl_blit_xywh(
  * @param y1
  * @param source pointer to a bitmap
  */
-static inline void hagl_blit_xyxy(
-    Display& display, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, hagl_bitmap_t* source)
+template <hagl::Surface S>
+inline void hagl_blit_xyxy(
+    S& display, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, hagl_bitmap_t* source)
 {
     hagl_blit_xywh(display, x0, y0, abs(x1 - x0) + 1, abs(y1 - y0) + 1, source);
 }
@@ -39,6 +39,15 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/bitmap.h"
+#include "hagl/blit.h"
+#include "fontx.h"
+
+/* If you want to use bigger fonts than 6x9 you need to define this. */
+#ifndef HAGL_CHAR_BUFFER_SIZE
+#define HAGL_CHAR_BUFFER_SIZE (6 * 9 * 2)
+#endif
 
 /**
  * Draw a single character
@@ -56,8 +65,42 @@ SPDX-License-Identifier: MIT
  * @param font  pointer to a FONTX font
  * @return width of the drawn character
  */
-uint8_t hagl_put_char(Display& display, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
-    const unsigned char* font, hagl_color_t bgColor);
+template <hagl::Surface S>
+uint8_t hagl_put_char(S& display, wchar_t code, int16_t x0, int16_t y0, hagl_color_t color,
+    const uint8_t* font, hagl_color_t bgColor)
+{
+    static hagl_color_t buffer[HAGL_CHAR_BUFFER_SIZE / sizeof(hagl_color_t)];
+
+    uint8_t set, status;
+    hagl_bitmap_t bitmap;
+    fontx_glyph_t glyph;
+
+    status = fontx_glyph(&glyph, code, font);
+
+    if (0 != status) {
+        return 0;
+    }
+
+    hagl_bitmap_init(&bitmap, glyph.width, glyph.height, display.depth, buffer);
+
+    hagl_color_t* ptr = (hagl_color_t*)bitmap.buffer;
+
+    for (uint8_t y = 0; y < glyph.height; y++) {
+        for (uint8_t x = 0; x < glyph.width; x++) {
+            set = *(glyph.buffer + x / 8) & (0x80 >> (x % 8));
+            if (set) {
+                *(ptr++) = color;
+            } else {
+                *(ptr++) = bgColor;
+            }
+        }
+        glyph.buffer += glyph.pitch;
+    }
+
+    hagl_blit(display, x0, y0, &bitmap);
+
+    return bitmap.width;
+}
 
 /**
  * Draw a string
@@ -75,8 +118,32 @@ uint8_t hagl_put_char(Display& display, wchar_t code, int16_t x0, int16_t y0, ha
  * @param font pointer to a FONTX font
  * @return width of the drawn string
  */
-uint16_t hagl_put_text(Display& display, const wchar_t* str, int16_t x0, int16_t y0,
-    hagl_color_t color, const unsigned char* font, hagl_color_t bgColor);
+template <hagl::Surface S>
+uint16_t hagl_put_text(S& display, const wchar_t* str, int16_t x0, int16_t y0,
+    hagl_color_t color, const unsigned char* font, hagl_color_t bgColor)
+{
+    wchar_t temp;
+    uint8_t status;
+    uint16_t original = x0;
+    fontx_meta_t meta;
+
+    status = fontx_meta(&meta, font);
+    if (0 != status) {
+        return 0;
+    }
+
+    do {
+        temp = *str++;
+        if (13 == temp || 10 == temp) {
+            x0 = 0;
+            y0 += meta.height;
+        } else {
+            x0 += hagl_put_char(display, temp, x0, y0, color, font, bgColor);
+        }
+    } while (*str != 0);
+
+    return x0 - original;
+}
 
 /**
  * Extract a glyph into a bitmap
@@ -91,7 +158,41 @@ uint16_t hagl_put_text(Display& display, const wchar_t* str, int16_t x0, int16_t
  * @param font Pointer to a FONTX font
  * @return Width of the drawn string
  */
+template <hagl::Surface S>
 uint8_t hagl_get_glyph(
-    Display& display, wchar_t code, hagl_color_t color, hagl_bitmap_t* bitmap, const uint8_t* font);
+    S& display, wchar_t code, hagl_color_t color, hagl_bitmap_t* bitmap, const uint8_t* font)
+{
+    uint8_t status, set;
+    fontx_glyph_t glyph;
+
+    status = fontx_glyph(&glyph, code, font);
+
+    if (0 != status) {
+        return status;
+    }
+
+    /* Initialise bitmap dimensions. */
+    bitmap->depth = display.depth;
+    bitmap->width = glyph.width;
+    bitmap->height = glyph.height;
+    bitmap->pitch = bitmap->width * (bitmap->depth / 8);
+    bitmap->size = bitmap->pitch * bitmap->height;
+
+    hagl_color_t* ptr = (hagl_color_t*)bitmap->buffer;
+
+    for (uint8_t y = 0; y < glyph.height; y++) {
+        for (uint8_t x = 0; x < glyph.width; x++) {
+            set = *(glyph.buffer) & (0x80 >> (x % 8));
+            if (set) {
+                *(ptr++) = color;
+            } else {
+                *(ptr++) = 0x0000;
+            }
+        }
+        glyph.buffer += glyph.pitch;
+    }
+
+    return 0;
+}
 
 #endif /* _HAGL_CHAR_H */
@@ -39,10 +39,11 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/pixel.h"
+#include "hagl/hline.h"
 
 
-class Display;
-
 /**
  * Draw a circle
  *
@@ -53,7 +54,42 @@ class Display;
  * @param r radius
  * @param color
  */
-void hagl_draw_circle(Display& display, int16_t x0, int16_t y0, int16_t r, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_circle(S& display, int16_t xc, int16_t yc, int16_t r, hagl_color_t color)
+{
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t d = 3 - 2 * r;
+
+    hagl_put_pixel(display, xc + x, yc + y, color);
+    hagl_put_pixel(display, xc - x, yc + y, color);
+    hagl_put_pixel(display, xc + x, yc - y, color);
+    hagl_put_pixel(display, xc - x, yc - y, color);
+    hagl_put_pixel(display, xc + y, yc + x, color);
+    hagl_put_pixel(display, xc - y, yc + x, color);
+    hagl_put_pixel(display, xc + y, yc - x, color);
+    hagl_put_pixel(display, xc - y, yc - x, color);
+
+    while (y >= x) {
+        if (d > 0) {
+            d = d + 4 * (x - y) + 10;
+            y--;
+            x++;
+        } else {
+            d = d + 4 * x + 6;
+            x++;
+        }
+
+        hagl_put_pixel(display, xc + x, yc + y, color);
+        hagl_put_pixel(display, xc - x, yc + y, color);
+        hagl_put_pixel(display, xc + x, yc - y, color);
+        hagl_put_pixel(display, xc - x, yc - y, color);
+        hagl_put_pixel(display, xc + y, yc + x, color);
+        hagl_put_pixel(display, xc - y, yc + x, color);
+        hagl_put_pixel(display, xc + y, yc - x, color);
+        hagl_put_pixel(display, xc - y, yc - x, color);
+    }
+}
 
 
 /**
@@ -66,8 +102,29 @@ void hagl_draw_circle(Display& display, int16_t x0, int16_t y0, int16_t r, hagl_
  * @param r radius
  * @param color
  */
-void hagl_fill_circle(
-    Display& display, int16_t x0, int16_t y0, int16_t r, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_fill_circle(S& display, int16_t x0, int16_t y0, int16_t r, hagl_color_t color)
+{
+    int16_t x = 0;
+    int16_t y = r;
+    int16_t d = 3 - 2 * r;
+
+    while (y >= x) {
+        hagl_draw_hline(display, x0 - x, y0 + y, x * 2, color);
+        hagl_draw_hline(display, x0 - x, y0 - y, x * 2, color);
+        hagl_draw_hline(display, x0 - y, y0 + x, y * 2, color);
+        hagl_draw_hline(display, x0 - y, y0 - x, y * 2, color);
+
+        if (d <= 0) {
+            d = d + 4 * x + 6;
+            x++;
+        } else {
+            d = d + 4 * (x - y) + 10;
+            x++;
+            y--;
+        }
+    }
+}
 
 
 #endif /* _HAGL_CIRCLE_H */
\ No newline at end of file
@@ -39,6 +39,7 @@ SPDX-License-Identifier: MIT
 #include <stdbool.h>
 
 #include "hagl/window.h"
+#include "hagl/surface.h"
 
 bool hagl_clip_line(int16_t* x0, int16_t* y0, int16_t* x1, int16_t* y1, hagl_window_t window);
 
@@ -54,7 +55,13 @@ bool hagl_clip_line(int16_t* x0, int16_t* y0, int16_t* x1, int16_t* y1, hagl_win
  * @param x1
  * @param y1
  */
-class Display;
-void hagl_set_clip(Display& display, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+template <hagl::Surface S>
+void hagl_set_clip(S& display, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    display.clip.x0 = x0;
+    display.clip.y0 = y0;
+    display.clip.x1 = x1;
+    display.clip.y1 = y1;
+}
 
 #endif /* _HAGL_CLIP_H */
\ No newline at end of file
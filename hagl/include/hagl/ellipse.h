@@ -39,6 +39,9 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/pixel.h"
+#include "hagl/hline.h"
 
 
 
@@ -54,8 +57,79 @@ SPDX-License-Identifier: MIT
  * @param b horizontal radius
  * @param color
  */
-void
-hagl_draw_ellipse(Display& display, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_ellipse(
+    S& display, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color)
+{
+    int16_t wx, wy;
+    int32_t xa, ya;
+    int32_t t;
+    int32_t asq = a * a;
+    int32_t bsq = b * b;
+
+    hagl_put_pixel(display, x0, y0 + b, color);
+    hagl_put_pixel(display, x0, y0 - b, color);
+
+    wx = 0;
+    wy = b;
+    xa = 0;
+    ya = asq * 2 * b;
+    t = asq / 4 - asq * b;
+
+    while (1) {
+        t += xa + bsq;
+
+        if (t >= 0) {
+            ya -= asq * 2;
+            t -= ya;
+            wy--;
+        }
+
+        xa += bsq * 2;
+        wx++;
+
+        if (xa >= ya) {
+            break;
+        }
+
+        hagl_put_pixel(display, x0 + wx, y0 - wy, color);
+        hagl_put_pixel(display, x0 - wx, y0 - wy, color);
+        hagl_put_pixel(display, x0 + wx, y0 + wy, color);
+        hagl_put_pixel(display, x0 - wx, y0 + wy, color);
+    }
+
+    hagl_put_pixel(display, x0 + a, y0, color);
+    hagl_put_pixel(display, x0 - a, y0, color);
+
+    wx = a;
+    wy = 0;
+    xa = bsq * 2 * a;
+
+    ya = 0;
+    t = bsq / 4 - bsq * a;
+
+    while (1) {
+        t += ya + asq;
+
+        if (t >= 0) {
+            xa -= bsq * 2;
+            t = t - xa;
+            wx--;
+        }
+
+        ya += asq * 2;
+        wy++;
+
+        if (ya > xa) {
+            break;
+        }
+
+        hagl_put_pixel(display, x0 + wx, y0 - wy, color);
+        hagl_put_pixel(display, x0 - wx, y0 - wy, color);
+        hagl_put_pixel(display, x0 + wx, y0 + wy, color);
+        hagl_put_pixel(display, x0 - wx, y0 + wy, color);
+    }
+}
 
 /**
  * Draw a filled ellipse
@@ -69,8 +143,74 @@ hagl_draw_ellipse(Display& display, int16_t x0, int16_t y0, int16_t a, int16_t b
  * @param b horizontal radius
  * @param color
  */
-void
-hagl_fill_ellipse(Display& display, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_fill_ellipse(
+    S& display, int16_t x0, int16_t y0, int16_t a, int16_t b, hagl_color_t color)
+{
+    int16_t wx, wy;
+    int32_t xa, ya;
+    int32_t t;
+    int32_t asq = a * a;
+    int32_t bsq = b * b;
+
+    hagl_put_pixel(display, x0, y0 + b, color);
+    hagl_put_pixel(display, x0, y0 - b, color);
+
+    wx = 0;
+    wy = b;
+    xa = 0;
+    ya = asq * 2 * b;
+    t = asq / 4 - asq * b;
+
+    while (1) {
+        t += xa + bsq;
+
+        if (t >= 0) {
+            ya -= asq * 2;
+            t -= ya;
+            wy--;
+        }
+
+        xa += bsq * 2;
+        wx++;
+
+        if (xa >= ya) {
+            break;
+        }
+
+        hagl_draw_hline(display, x0 - wx, y0 - wy, wx * 2, color);
+        hagl_draw_hline(display, x0 - wx, y0 + wy, wx * 2, color);
+    }
+
+    hagl_draw_hline(display, x0 - a, y0, a * 2, color);
+
+    wx = a;
+    wy = 0;
+    xa = bsq * 2 * a;
+
+    ya = 0;
+    t = bsq / 4 - bsq * a;
+
+    while (1) {
+        t += ya + asq;
+
+        if (t >= 0) {
+            xa -= bsq * 2;
+            t = t - xa;
+            wx--;
+        }
+
+        ya += asq * 2;
+        wy++;
+
+        if (ya > xa) {
+            break;
+        }
+
+        hagl_draw_hline(display, x0 - wx, y0 - wy, wx * 2, color);
+        hagl_draw_hline(display, x0 - wx, y0 + wy, wx * 2, color);
+    }
+}
 
 
 #endif /* _HAGL_ELLIPSE_H */
\ No newline at end of file
@@ -0,0 +1,75 @@
+/*
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef _HAGL_GRADIENT_H
+#define _HAGL_GRADIENT_H
+
+#include <stdint.h>
+
+#include "hagl/color.h"
+#include "rgb888.h"
+
+#ifndef HAGL_GRADIENT_STOPS
+#define HAGL_GRADIENT_STOPS (64)
+#endif
+
+/* Maps 0...100 to 0...HAGL_GRADIENT_STOPS - 1 with a multiply and a shift. */
+#define HAGL_GRADIENT_SCALE ((((HAGL_GRADIENT_STOPS) - 1) * 65536 + 99) / 100)
+
+/*
+Precomputed color ramp. Colors are stored in display byte order so
+they can be passed to the drawing functions as is.
+*/
+typedef struct {
+    hagl_color_t stops[HAGL_GRADIENT_STOPS];
+} hagl_gradient_t;
+
+/**
+ * Fill a gradient by sweeping the hue
+ *
+ * Hue is interpolated linearly from h0 to h1 with constant
+ * saturation and lightness. For example 85 to 0 gives the usual
+ * green - yellow - red load ramp.
+ *
+ * @param gradient
+ * @param h0 hue of the first stop
+ * @param h1 hue of the last stop
+ * @param s saturation
+ * @param l lightness
+ */
+void hagl_gradient_hsl(hagl_gradient_t *gradient, uint8_t h0, uint8_t h1, uint8_t s, uint8_t l);
+
+/**
+ * Fill a gradient by interpolating between two RGB colors
+ *
+ * @param gradient
+ * @param from color of the first stop
+ * @param to color of the last stop
+ */
+void hagl_gradient_rgb(hagl_gradient_t *gradient, rgb_t from, rgb_t to);
+
+/**
+ * Get gradient color for a percentage
+ *
+ * Values over 100 are clamped. Costs one table lookup.
+ *
+ * @param gradient
+ * @param percent 0...100
+ * @return color
+ */
+static inline hagl_color_t
+hagl_gradient_color(const hagl_gradient_t *gradient, uint8_t percent)
+{
+    if (percent > 100) {
+        percent = 100;
+    }
+    return gradient->stops[(percent * HAGL_GRADIENT_SCALE) >> 16];
+}
+
+#endif /* _HAGL_GRADIENT_H */
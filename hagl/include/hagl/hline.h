@@ -40,6 +40,8 @@ SPDX-License-Identifier: MIT
 #include <stdlib.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/pixel.h"
 
 
 
@@ -55,8 +57,34 @@ SPDX-License-Identifier: MIT
  * @param color
  */
 
-void
-hagl_draw_hline_xyw(Display& display, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_hline_xyw(S& display, int16_t x0, int16_t y0, uint16_t w, hagl_color_t color)
+{
+    int16_t width = w;
+
+    /* x0 or y0 is over the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1) || (y0 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 is left of clip window, ignore start part. */
+    if (x0 < display.clip.x0) {
+        width = width + x0;
+        x0 = display.clip.x0;
+    }
+
+    /* Everything outside clip window, nothing to do. */
+    if (width <= 0) {
+        return;
+    }
+
+    /* Cut anything going over right edge of clip window. */
+    if (((x0 + width) > display.clip.x1)) {
+        width = width - (x0 + width - 1 - display.clip.x1);
+    }
+
+    display.drawHlineInner(x0, y0, width, color);
+}
 
 /**
  * Draw a horizontal line
@@ -70,8 +98,9 @@ hagl_draw_hline_xyw(Display& display, int16_t x0, int16_t y0, uint16_t width, ha
  * @param color
  */
 
-static inline void
-hagl_draw_hline_xyx(Display& display, int16_t x0, int16_t y0, int16_t x1, hagl_color_t color)
+template <hagl::Surface S>
+inline void
+hagl_draw_hline_xyx(S& display, int16_t x0, int16_t y0, int16_t x1, hagl_color_t color)
 {
     hagl_draw_hline_xyw(display, x0, y0, abs(x1 - x0) + 1, color);
 }
@@ -88,8 +117,9 @@ hagl_draw_hline_xyx(Display& display, int16_t x0, int16_t y0, int16_t x1, hagl_c
  * @param color
  */
 
-static inline void
-hagl_draw_hline(Display& display, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+template <hagl::Surface S>
+inline void
+hagl_draw_hline(S& display, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
 {
     hagl_draw_hline_xyw(display, x0, y0, width, color);
 }
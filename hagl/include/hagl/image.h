@@ -36,24 +36,243 @@ SPDX-License-Identifier: MIT
 #ifndef _HAGL_IMAGE_H
 #define _HAGL_IMAGE_H
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "hagl/bitmap.h"
+#include "hagl/color.h"
+#include "hagl/surface.h"
+#include "tjpgd.h"
+
+/* Same value as in hagl.h, which can only be built with the HAL. */
+#ifndef HAGL_OK
+#define HAGL_OK (0)
+#endif
 
 #define HAGL_ERR_TJPGD (100)
+
+/* Height of the decoded band, must fit the tallest MCU (16 pixels). */
+#ifndef HAGL_IMAGE_BAND_HEIGHT
+#define HAGL_IMAGE_BAND_HEIGHT (16)
+#endif
+
+/* Decoder work area, enough for any baseline image. */
+#define HAGL_IMAGE_WORK_SIZE (3100)
+
 class Display;
+
 /**
- * Load an image
+ * Image input callback
+ *
+ * Copies up to size bytes into buffer and returns the number of bytes
+ * copied. When buffer is NULL the bytes should be skipped instead.
+ * Returning less than requested ends the stream.
+ */
+typedef uint16_t (*hagl_image_reader_t)(void* context, uint8_t* buffer, uint16_t size);
+
+template <hagl::Surface S>
+struct hagl_image_device_t {
+    S* display;
+    hagl_image_reader_t reader;
+    void* context;
+    int16_t x0;
+    int16_t y0;
+    /* Visible columns in screen coordinates. */
+    int16_t vx0;
+    int16_t vx1;
+    /* Two bands, one is decoded into while the other one is being sent. */
+    hagl_color_t (*bands)[S::width * HAGL_IMAGE_BAND_HEIGHT];
+    /* Band currently being filled. */
+    uint8_t band;
+    bool done;
+};
+
+template <hagl::Surface S>
+uint16_t
+hagl_image_input(JDEC *decoder, uint8_t *buffer, uint16_t size)
+{
+    hagl_image_device_t<S> *device = (hagl_image_device_t<S> *)decoder->device;
+    return device->reader(device->context, buffer, size);
+}
+
+template <hagl::Surface S>
+uint16_t
+hagl_image_output(JDEC *decoder, void *bitmap, JRECT *rectangle)
+{
+    hagl_image_device_t<S> *device = (hagl_image_device_t<S> *)decoder->device;
+    S &display = *device->display;
+    uint16_t width = (rectangle->right - rectangle->left) + 1;
+    uint16_t height = (rectangle->bottom - rectangle->top) + 1;
+    int16_t vw = device->vx1 - device->vx0 + 1;
+    hagl_color_t *band = device->bands[device->band];
+
+    /* Copy the visible columns of the block into the band. */
+    int16_t bx0 = device->x0 + rectangle->left;
+    int16_t from = std::max(bx0, device->vx0);
+    int16_t to = std::min<int16_t>(bx0 + width - 1, device->vx1);
+
+    if (from <= to) {
+        const hagl_color_t *src = (const hagl_color_t *)bitmap + (from - bx0);
+        hagl_color_t *dst = band + (from - device->vx0);
+        for (uint16_t y = 0; y < height; y++) {
+            memcpy(dst, src, (to - from + 1) * sizeof(hagl_color_t));
+            src += width;
+            dst += vw;
+        }
+    }
+
+    /* Wait until the whole MCU row is in the band. */
+    if ((rectangle->right + 1) < (decoder->width >> decoder->scale)) {
+        return 1;
+    }
+
+    int16_t by0 = device->y0 + rectangle->top;
+    int16_t vy0 = std::max<int16_t>(by0, display.clip.y0);
+    int16_t vy1 = std::min<int16_t>(by0 + height - 1, display.clip.y1);
+
+    if (vy0 <= vy1) {
+        hagl_bitmap_t bitmap;
+        hagl_bitmap_init(&bitmap, vw, vy1 - vy0 + 1, display.depth, band + (vy0 - by0) * vw);
+        /* Surfaces with DMA send the band while the next one is decoded. */
+        if constexpr (requires { display.blit_async(device->vx0, vy0, &bitmap); }) {
+            display.blit_async(device->vx0, vy0, &bitmap);
+        } else {
+            display.blit(device->vx0, vy0, &bitmap);
+        }
+        device->band ^= 1;
+    }
+
+    /* Nothing below this band is visible, stop decoding. */
+    if (by0 + height > display.clip.y1) {
+        device->done = true;
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * Load an image from a stream
  *
  * Output will be clipped to the current clip window. Does not do
  * any scaling. Currently supports only baseline jpg images
  * (i.e. it does not support progressive jpg).
  *
+ * Decoded MCUs are collected into full width bands which are sent with
+ * DMA while the next band is being decoded. Decoding stops as soon as
+ * the rest of the image would fall below the clip window. The bands
+ * and the work area are static, one per surface type, so images are
+ * loaded from one thread at a time.
+ *
+ * @param display
+ * @param x0
+ * @param y0
+ * @param reader input callback
+ * @param context passed as is to the reader
+ */
+template <hagl::Surface S>
+uint32_t
+hagl_load_image_reader(
+    S &display, int16_t x0, int16_t y0, hagl_image_reader_t reader, void *context)
+{
+    static uint8_t work[HAGL_IMAGE_WORK_SIZE];
+    static hagl_color_t bands[2][S::width * HAGL_IMAGE_BAND_HEIGHT];
+    JDEC decoder;
+    JRESULT result;
+    hagl_image_device_t<S> device;
+
+    device.display = &display;
+    device.reader = reader;
+    device.context = context;
+    device.x0 = x0;
+    device.y0 = y0;
+    device.bands = bands;
+    device.band = 0;
+    device.done = false;
+
+    result = jd_prepare(
+        &decoder, hagl_image_input<S>, work, HAGL_IMAGE_WORK_SIZE, (void *)&device);
+    if (JDR_OK != result) {
+        return HAGL_ERR_TJPGD + result;
+    }
+
+    device.vx0 = std::max<int16_t>(x0, display.clip.x0);
+    device.vx1 = std::min<int16_t>(x0 + decoder.width - 1, display.clip.x1);
+
+    if ((device.vx1 < device.vx0) || (y0 > display.clip.y1) ||
+        (y0 + decoder.height - 1 < display.clip.y0)) {
+        return HAGL_OK;
+    }
+
+    result = jd_decomp(&decoder, hagl_image_output<S>, 0);
+
+    /* Bands are static, the last one has to be out before returning. */
+    if constexpr (requires { S::wait_transfer(); }) {
+        S::wait_transfer();
+    }
+
+    if (JDR_OK != result && !(JDR_INTR == result && device.done)) {
+        return HAGL_ERR_TJPGD + result;
+    }
+
+    return HAGL_OK;
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t position;
+} hagl_image_memory_t;
+
+static inline uint16_t
+hagl_image_memory_reader(void *context, uint8_t *buffer, uint16_t size)
+{
+    hagl_image_memory_t *memory = (hagl_image_memory_t *)context;
+    size_t available = memory->size - memory->position;
+
+    if (size > available) {
+        size = (uint16_t)available;
+    }
+    if (buffer) {
+        memcpy(buffer, memory->data + memory->position, size);
+    }
+    memory->position += size;
+    return size;
+}
+
+/**
+ * Load an image from memory
+ *
+ * The data is read in place, nothing is copied besides the decoder
+ * input buffer.
+ *
+ * @param display
+ * @param x0
+ * @param y0
+ * @param data jpg file contents
+ * @param size size of the data in bytes
+ */
+template <hagl::Surface S>
+uint32_t
+hagl_load_image_memory(S &display, int16_t x0, int16_t y0, const uint8_t *data, size_t size)
+{
+    hagl_image_memory_t memory = {data, size, 0};
+    return hagl_load_image_reader(display, x0, y0, hagl_image_memory_reader, &memory);
+}
+
+/**
+ * Load an image from a file
+ *
+ * Same as hagl_load_image_reader() with the file as the stream.
+ *
  * @param display
  * @param x0
  * @param y0
- * @param x1
- * @param y1
- * @param color
+ * @param filename
  */
-uint32_t hagl_load_image(Display& display, int16_t x0, int16_t y0, const char* filename);
+uint32_t hagl_load_image(Display &display, int16_t x0, int16_t y0, const char *filename);
 
 #endif /* _HAGL_IMAGE_H */
@@ -37,10 +37,12 @@ SPDX-License-Identifier: MIT
 #define _HAGL_LINE_H
 
 #include <stdint.h>
+#include <stdlib.h>
 
 #include "hagl/color.h"
-
-class Display;
+#include "hagl/surface.h"
+#include "hagl/clip.h"
+#include "hagl/pixel.h"
 
 /**
  * Draw a line
@@ -54,8 +56,48 @@ class Display;
  * @param y1
  * @param color
  */
-void
-hagl_draw_line(Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_line(
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
+{
+    /* Clip coordinates to fit clip window. */
+    if (false == hagl_clip_line(&x0, &y0, &x1, &y1, display.clip)) {
+        return;
+    }
+
+    int16_t dx;
+    int16_t sx;
+    int16_t dy;
+    int16_t sy;
+    int16_t err;
+    int16_t e2;
+
+    dx = abs(x1 - x0);
+    sx = x0 < x1 ? 1 : -1;
+    dy = abs(y1 - y0);
+    sy = y0 < y1 ? 1 : -1;
+    err = (dx > dy ? dx : -dy) / 2;
+
+    while (1) {
+        hagl_put_pixel(display, x0, y0, color);
+
+        if (x0 == x1 && y0 == y1) {
+            break;
+        };
+
+        e2 = err + err;
+
+        if (e2 > -dx) {
+            err -= dy;
+            x0 += sx;
+        }
+
+        if (e2 < dy) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
 
 
 #endif /* _HAGL_LINE_H */
\ No newline at end of file
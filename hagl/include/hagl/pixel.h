@@ -39,7 +39,7 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
-#include "Display.h"
+#include "hagl/surface.h"
 
 
 /**
@@ -52,7 +52,22 @@ SPDX-License-Identifier: MIT
  * @param y0
  * @param color
  */
-void hagl_put_pixel(Display& display, int16_t x0, int16_t y0, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_put_pixel(S& display, int16_t x0, int16_t y0, hagl_color_t color)
+{
+    /* x0 or y0 is before the edge, nothing to do. */
+    if ((x0 < display.clip.x0) || (y0 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    /* If still in bounds set the pixel. */
+    display.put_pixel(x0, y0, color);
+}
 
 /**
  * Get a single pixel
@@ -65,7 +80,25 @@ void hagl_put_pixel(Display& display, int16_t x0, int16_t y0, hagl_color_t color
  * @param y0
  * @return color at the given location
  */
-hagl_color_t hagl_get_pixel(Display& display, int16_t x0, int16_t y0);
+template <hagl::Surface S>
+hagl_color_t hagl_get_pixel(S& display, int16_t x0, int16_t y0)
+{
+    /* x0 or y0 is before the edge, nothing to do. */
+    if ((x0 < display.clip.x0) || (y0 < display.clip.y0)) {
+        return hagl_color(0, 0, 0);
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return hagl_color(0, 0, 0);
+    }
+
+    //if (display.get_pixel) {
+    //    return display.get_pixel(display, x0, y0);
+    //}
+
+    return hagl_color(0, 0, 0);
+}
 
 
 #endif /* _HAGL_PIXEL_H */
\ No newline at end of file
@@ -39,8 +39,9 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
-
-class Display;
+#include "hagl/surface.h"
+#include "hagl/line.h"
+#include "hagl/hline.h"
 
 /**
  * Draw a polygon
@@ -57,8 +58,16 @@ class Display;
  * @param vertices pointer to (an array) of vertices
  * @param color
  */
-void
-hagl_draw_polygon(Display& display, int16_t amount, int16_t *vertices, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_polygon(S& display, int16_t amount, int16_t* vertices, hagl_color_t color)
+{
+    for (int16_t i = 0; i < amount - 1; i++) {
+        hagl_draw_line(display, vertices[(i << 1) + 0], vertices[(i << 1) + 1],
+            vertices[(i << 1) + 2], vertices[(i << 1) + 3], color);
+    }
+    hagl_draw_line(display, vertices[0], vertices[1], vertices[(amount << 1) - 2],
+        vertices[(amount << 1) - 1], color);
+}
 
 /**
  * Draw a filled polygon
@@ -75,8 +84,71 @@ hagl_draw_polygon(Display& display, int16_t amount, int16_t *vertices, hagl_colo
  * @param vertices pointer to (an array) of vertices
  * @param color
  */
-void
-hagl_fill_polygon(Display& display, int16_t amount, int16_t *vertices, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_fill_polygon(
+    S& display, int16_t amount, int16_t* vertices, hagl_color_t color)
+{
+    uint16_t nodes[64];
+    int16_t y;
+
+    float x0;
+    float y0;
+    float x1;
+    float y1;
+
+    int16_t miny = display.height;
+    int16_t maxy = 0;
+
+    for (uint8_t i = 0; i < amount; i++) {
+        if (miny > vertices[(i << 1) + 1]) {
+            miny = vertices[(i << 1) + 1];
+        }
+        if (maxy < vertices[(i << 1) + 1]) {
+            maxy = vertices[(i << 1) + 1];
+        }
+    }
+
+    /*  Loop through the rows of the image. */
+    for (y = miny; y < maxy; y++) {
+        /*  Build a list of nodes. */
+        int16_t count = 0;
+        int16_t j = amount - 1;
+
+        for (int16_t i = 0; i < amount; i++) {
+            x0 = vertices[(i << 1) + 0];
+            y0 = vertices[(i << 1) + 1];
+            x1 = vertices[(j << 1) + 0];
+            y1 = vertices[(j << 1) + 1];
+
+            if ((y0 < (float)y && y1 >= (float)y) || (y1 < (float)y && y0 >= (float)y)) {
+                nodes[count] = (int16_t)(x0 + (y - y0) / (y1 - y0) * (x1 - x0));
+                count++;
+            }
+            j = i;
+        }
+
+        /* Sort the nodes, via a simple “Bubble” sort. */
+        int16_t i = 0;
+        while (i < count - 1) {
+            if (nodes[i] > nodes[i + 1]) {
+                int16_t swap = nodes[i];
+                nodes[i] = nodes[i + 1];
+                nodes[i + 1] = swap;
+                if (i) {
+                    i--;
+                }
+            } else {
+                i++;
+            }
+        }
+
+        /* Draw lines between nodes. */
+        for (int16_t i = 0; i < count; i += 2) {
+            int16_t width = nodes[i + 1] - nodes[i];
+            hagl_draw_hline(display, nodes[i], y, width, color);
+        }
+    }
+}
 
 
 #endif /* _HAGL_POLYGON_H */
\ No newline at end of file
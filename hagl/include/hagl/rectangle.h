@@ -38,7 +38,12 @@ SPDX-License-Identifier: MIT
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/hline.h"
+#include "hagl/vline.h"
 
 
 
@@ -54,8 +59,42 @@ SPDX-License-Identifier: MIT
  * @param y1
  * @param color
  */
+template <hagl::Surface S>
 void hagl_draw_rectangle_xyxy(
-    Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color);
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
+{
+    /* Make sure x0 is smaller than x1. */
+    if (x0 > x1) {
+        x0 = x0 + x1;
+        x1 = x0 - x1;
+        x0 = x0 - x1;
+    }
+
+    /* Make sure y0 is smaller than y1. */
+    if (y0 > y1) {
+        y0 = y0 + y1;
+        y1 = y0 - y1;
+        y0 = y0 - y1;
+    }
+
+    /* x1 or y1 is before the edge, nothing to do. */
+    if ((x1 < display.clip.x0) || (y1 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    uint16_t width = x1 - x0 + 1;
+    uint16_t height = y1 - y0 + 1;
+
+    hagl_draw_hline(display, x0, y0, width, color);
+    hagl_draw_hline(display, x0, y1, width, color);
+    hagl_draw_vline(display, x0, y0, height, color);
+    hagl_draw_vline(display, x1, y0, height, color);
+}
 
 /**
  * Draw a rectangle
@@ -69,8 +108,9 @@ void hagl_draw_rectangle_xyxy(
  * @param y1
  * @param color
  */
-static inline void hagl_draw_rectangle(
-    Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
+template <hagl::Surface S>
+inline void hagl_draw_rectangle(
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
 {
     hagl_draw_rectangle_xyxy(display, x0, y0, x1, y1, color);
 }
@@ -87,7 +127,8 @@ static inline void hagl_draw_rectangle(
  * @param height
  * @param color
  */
-static inline void hagl_draw_rectangle_xywh(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_draw_rectangle_xywh(S& display, int16_t x0, int16_t y0,
     uint16_t width, uint16_t height, hagl_color_t color)
 {
     hagl_draw_rectangle_xyxy(display, x0, y0, x0 + width - 1, y0 + height - 1, color);
@@ -105,8 +146,54 @@ static inline void hagl_draw_rectangle_xywh(Display& display, int16_t x0, int16_
  * @param y1
  * @param color
  */
+template <hagl::Surface S>
 void hagl_fill_rectangle_xyxy(
-    Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color);
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
+{
+    /* Make sure x0 is smaller than x1. */
+    if (x0 > x1) {
+        x0 = x0 + x1;
+        x1 = x0 - x1;
+        x0 = x0 - x1;
+    }
+
+    /* Make sure y0 is smaller than y1. */
+    if (y0 > y1) {
+        y0 = y0 + y1;
+        y1 = y0 - y1;
+        y0 = y0 - y1;
+    }
+
+    /* x1 or y1 is before the edge, nothing to do. */
+    if ((x1 < display.clip.x0) || (y1 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    x0 = std::max<int16_t>(x0, display.clip.x0);
+    y0 = std::max<int16_t>(y0, display.clip.y0);
+    x1 = std::min<int16_t>(x1, display.clip.x1);
+    y1 = std::min<int16_t>(y1, display.clip.y1);
+
+    uint16_t width = x1 - x0 + 1;
+    uint16_t height = y1 - y0 + 1;
+
+    /* Already clipped so can call HAL directly, fewest lines first. */
+    if (height > width) {
+        for (uint16_t i = 0; i < width; i++) {
+            display.drawVlineInner(x0 + i, y0, height, color);
+        }
+        return;
+    }
+
+    for (uint16_t i = 0; i < height; i++) {
+        display.drawHlineInner(x0, y0 + i, width, color);
+    }
+}
 
 /**
  * Draw a filled rectangle
@@ -121,8 +208,9 @@ void hagl_fill_rectangle_xyxy(
  * @param color
  */
 
-static inline void hagl_fill_rectangle(
-    Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
+template <hagl::Surface S>
+inline void hagl_fill_rectangle(
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, hagl_color_t color)
 {
     hagl_fill_rectangle_xyxy(display, x0, y0, x1, y1, color);
 }
@@ -139,7 +227,8 @@ static inline void hagl_fill_rectangle(
  * @param height
  * @param color
  */
-static inline void hagl_fill_rectangle_xywh(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_fill_rectangle_xywh(S& display, int16_t x0, int16_t y0,
     uint16_t width, uint16_t height, hagl_color_t color)
 {
     hagl_fill_rectangle_xyxy(display, x0, y0, x0 + width - 1, y0 + height - 1, color);
@@ -158,8 +247,78 @@ static inline void hagl_fill_rectangle_xywh(Display& display, int16_t x0, int16_
  * @param r corner radius
  * @param color
  */
-void hagl_draw_rounded_rectangle_xyxy(Display& display, int16_t x0, int16_t y0, int16_t x1,
-    int16_t y1, int16_t r, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_rounded_rectangle_xyxy(
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, hagl_color_t color)
+{
+    uint16_t width, height;
+    int16_t x, y, d;
+
+    /* Make sure x0 is smaller than x1. */
+    if (x0 > x1) {
+        x0 = x0 + x1;
+        x1 = x0 - x1;
+        x0 = x0 - x1;
+    }
+
+    /* Make sure y0 is smaller than y1. */
+    if (y0 > y1) {
+        y0 = y0 + y1;
+        y1 = y0 - y1;
+        y0 = y0 - y1;
+    }
+
+    /* x1 or y1 is before the edge, nothing to do. */
+    if ((x1 < display.clip.x0) || (y1 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    /* Max radius is half of shortest edge. */
+    width = x1 - x0 + 1;
+    height = y1 - y0 + 1;
+    r = std::min<int16_t>(r, std::min(width, height) / 2);
+
+    hagl_draw_hline(display, x0 + r, y0, width - 2 * r, color);
+    hagl_draw_hline(display, x0 + r, y1, width - 2 * r, color);
+    hagl_draw_vline(display, x0, y0 + r, height - 2 * r, color);
+    hagl_draw_vline(display, x1, y0 + r, height - 2 * r, color);
+
+    x = 0;
+    y = r;
+    d = 3 - 2 * r;
+
+    while (y >= x) {
+        x++;
+
+        if (d > 0) {
+            y--;
+            d = d + 4 * (x - y) + 10;
+        } else {
+            d = d + 4 * x + 6;
+        }
+
+        /* Top right */
+        hagl_put_pixel(display, x1 - r + x, y0 + r - y, color);
+        hagl_put_pixel(display, x1 - r + y, y0 + r - x, color);
+
+        /* Top left */
+        hagl_put_pixel(display, x0 + r - x, y0 + r - y, color);
+        hagl_put_pixel(display, x0 + r - y, y0 + r - x, color);
+
+        /* Bottom right */
+        hagl_put_pixel(display, x1 - r + x, y1 - r + y, color);
+        hagl_put_pixel(display, x1 - r + y, y1 - r + x, color);
+
+        /* Bottom left */
+        hagl_put_pixel(display, x0 + r - x, y1 - r + y, color);
+        hagl_put_pixel(display, x0 + r - y, y1 - r + x, color);
+    }
+}
 
 /**
  * Draw a rounded rectangle
@@ -174,7 +333,8 @@ void hagl_draw_rounded_rectangle_xyxy(Display& display, int16_t x0, int16_t y0,
  * @param r corner radius
  * @param color
  */
-static inline void hagl_draw_rounded_rectangle(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_draw_rounded_rectangle(S& display, int16_t x0, int16_t y0,
     int16_t x1, int16_t y1, int16_t r, hagl_color_t color)
 {
     hagl_draw_rounded_rectangle_xyxy(display, x0, y0, x1, y1, r, color);
@@ -193,7 +353,8 @@ static inline void hagl_draw_rounded_rectangle(Display& display, int16_t x0, int
  * @param r corner radius
  * @param color
  */
-static inline void hagl_draw_rounded_rectangle_xywh(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_draw_rounded_rectangle_xywh(S& display, int16_t x0, int16_t y0,
     uint16_t width, uint16_t height, int16_t r, hagl_color_t color)
 {
     hagl_draw_rounded_rectangle_xyxy(display, x0, y0, x0 + width - 1, y0 + height - 1, r, color);
@@ -212,8 +373,86 @@ static inline void hagl_draw_rounded_rectangle_xywh(Display& display, int16_t x0
  * @param r corner radius
  * @param color
  */
-void hagl_fill_rounded_rectangle_xyxy(Display& display, int16_t x0, int16_t y0, int16_t x1,
-    int16_t y1, int16_t r, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_fill_rounded_rectangle_xyxy(
+    S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, hagl_color_t color)
+{
+    uint16_t width, height;
+    int16_t rx0, ry0, rx1, x, y, d;
+
+    /* Make sure x0 is smaller than x1. */
+    if (x0 > x1) {
+        x0 = x0 + x1;
+        x1 = x0 - x1;
+        x0 = x0 - x1;
+    }
+
+    /* Make sure y0 is smaller than y1. */
+    if (y0 > y1) {
+        y0 = y0 + y1;
+        y1 = y0 - y1;
+        y0 = y0 - y1;
+    }
+
+    /* x1 or y1 is before the edge, nothing to do. */
+    if ((x1 < display.clip.x0) || (y1 < display.clip.y0)) {
+        return;
+    }
+
+    /* x0 or y0 is after the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    /* Max radius is half of shortest edge. */
+    width = x1 - x0 + 1;
+    height = y1 - y0 + 1;
+    r = std::min<int16_t>(r, std::min(width, height) / 2);
+
+    x = 0;
+    y = r;
+    d = 3 - 2 * r;
+
+    while (y >= x) {
+        x++;
+
+        if (d > 0) {
+            y--;
+            d = d + 4 * (x - y) + 10;
+        } else {
+            d = d + 4 * x + 6;
+        }
+
+        /* Top  */
+        ry0 = y0 + r - x;
+        rx0 = x0 + r - y;
+        rx1 = x1 - r + y;
+        width = rx1 - rx0;
+        hagl_draw_hline(display, rx0, ry0, width, color);
+
+        ry0 = y0 + r - y;
+        rx0 = x0 + r - x;
+        rx1 = x1 - r + x;
+        width = rx1 - rx0;
+        hagl_draw_hline(display, rx0, ry0, width, color);
+
+        /* Bottom */
+        ry0 = y1 - r + y;
+        rx0 = x0 + r - x;
+        rx1 = x1 - r + x;
+        width = rx1 - rx0;
+        hagl_draw_hline(display, rx0, ry0, width, color);
+
+        ry0 = y1 - r + x;
+        rx0 = x0 + r - y;
+        rx1 = x1 - r + y;
+        width = rx1 - rx0;
+        hagl_draw_hline(display, rx0, ry0, width, color);
+    }
+
+    /* Center */
+    hagl_fill_rectangle_xyxy(display, x0, y0 + r, x1, y1 - r, color);
+}
 
 /**
  * Draw a filled rounded rectangle
@@ -228,7 +467,8 @@ void hagl_fill_rounded_rectangle_xyxy(Display& display, int16_t x0, int16_t y0,
  * @param r corner radius
  * @param color
  */
-static inline void hagl_fill_rounded_rectangle(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_fill_rounded_rectangle(S& display, int16_t x0, int16_t y0,
     int16_t x1, int16_t y1, int16_t r, hagl_color_t color)
 {
     hagl_fill_rounded_rectangle_xyxy(display, x0, y0, x1, y1, r, color);
@@ -247,7 +487,8 @@ static inline void hagl_fill_rounded_rectangle(Display& display, int16_t x0, int
  * @param r corner radius
  * @param color
  */
-static inline void hagl_fill_rounded_rectangle_xywh(Display& display, int16_t x0, int16_t y0,
+template <hagl::Surface S>
+inline void hagl_fill_rounded_rectangle_xywh(S& display, int16_t x0, int16_t y0,
     uint16_t width, uint16_t height, int16_t r, hagl_color_t color)
 {
     hagl_fill_rounded_rectangle_xyxy(display, x0, y0, x0 + width - 1, y0 + height - 1, r, color);
@@ -0,0 +1,251 @@
+/*
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef _HAGL_SPRITE_H
+#define _HAGL_SPRITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+
+#include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/hline.h"
+
+/*
+Sprites are run length encoded palette images. Runs are stored as
+(count, index) byte pairs in raster order and may continue across
+rows. Count is 1...255.
+
+There is no transparent index, every pixel of the bounding box is
+written so the sprite can be sent as one window. The area around a
+shape, such as the corners of a rounded rectangle, gets its palette
+colour and has to match what is behind the sprite.
+*/
+struct hagl_sprite_t {
+    uint16_t width;
+    uint16_t height;
+    const hagl_color_t *palette;
+    const uint8_t *runs;
+    uint16_t size;
+};
+
+/**
+ * Draw a sprite
+ *
+ * Output will be clipped to the current clip window. On surfaces with
+ * a sprite() operation, such as Display, a sprite fully inside the clip
+ * window is decoded straight into the SPI stream as one address window.
+ *
+ * @param display
+ * @param x0
+ * @param y0
+ * @param sprite
+ */
+template <hagl::Surface S>
+void
+hagl_blit_sprite(S &display, int16_t x0, int16_t y0, const hagl_sprite_t *sprite)
+{
+    int16_t x1 = x0 + sprite->width - 1;
+    int16_t y1 = y0 + sprite->height - 1;
+
+    /* Fully outside of the clip window, nothing to do. */
+    if ((x1 < display.clip.x0) || (y1 < display.clip.y0) ||
+        (x0 > display.clip.x1) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    /* Fully inside and the surface can decode runs itself, stream as one window. */
+    if constexpr (requires { display.sprite(x0, y0, sprite); }) {
+        if ((x0 >= display.clip.x0) && (y0 >= display.clip.y0) &&
+            (x1 <= display.clip.x1) && (y1 <= display.clip.y1)) {
+            display.sprite(x0, y0, sprite);
+            return;
+        }
+    }
+
+    /* Otherwise split the runs into clipped horizontal lines. */
+    uint16_t x = 0;
+    uint16_t y = 0;
+
+    for (uint16_t i = 0; i < sprite->size; i += 2) {
+        uint16_t count = sprite->runs[i];
+        hagl_color_t color = sprite->palette[sprite->runs[i + 1]];
+
+        while (count) {
+            /* Rest of the sprite is below the clip window. */
+            if (y0 + y > display.clip.y1) {
+                return;
+            }
+            uint16_t width = std::min<uint16_t>(count, sprite->width - x);
+            hagl_draw_hline_xyw(display, x0 + x, y0 + y, width, color);
+            count -= width;
+            x += width;
+            if (x == sprite->width) {
+                x = 0;
+                y++;
+            }
+        }
+    }
+}
+
+namespace hagl
+{
+
+/**
+ * Compile time canvas of palette indices
+ *
+ * Shapes are rasterised with the same algorithms as the runtime
+ * primitives so sprites match what would have been drawn directly.
+ */
+template <uint16_t W, uint16_t H>
+struct SpriteCanvas {
+    static constexpr uint16_t width = W;
+    static constexpr uint16_t height = H;
+    uint8_t pixels[W * H]{};
+
+    constexpr void
+    hline(int16_t x0, int16_t y0, int16_t w, uint8_t index)
+    {
+        if (y0 < 0 || y0 >= H) {
+            return;
+        }
+        for (int16_t x = x0; x < x0 + w; x++) {
+            if (x >= 0 && x < W) {
+                pixels[y0 * W + x] = index;
+            }
+        }
+    }
+
+    constexpr void
+    vline(int16_t x0, int16_t y0, int16_t h, uint8_t index)
+    {
+        for (int16_t y = y0; y < y0 + h; y++) {
+            hline(x0, y, 1, index);
+        }
+    }
+
+    constexpr void
+    fill_rectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t index)
+    {
+        for (int16_t y = y0; y <= y1; y++) {
+            hline(x0, y, x1 - x0 + 1, index);
+        }
+    }
+
+    /* Mirrors hagl_fill_rounded_rectangle_xyxy(). */
+    constexpr void
+    fill_rounded_rectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t r, uint8_t index)
+    {
+        int16_t w = x1 - x0 + 1;
+        int16_t h = y1 - y0 + 1;
+        r = (r < w / 2) ? r : w / 2;
+        r = (r < h / 2) ? r : h / 2;
+
+        int16_t x = 0;
+        int16_t y = r;
+        int16_t d = 3 - 2 * r;
+
+        while (y >= x) {
+            x++;
+            if (d > 0) {
+                y--;
+                d = d + 4 * (x - y) + 10;
+            } else {
+                d = d + 4 * x + 6;
+            }
+            hline(x0 + r - y, y0 + r - x, (x1 - r + y) - (x0 + r - y), index);
+            hline(x0 + r - x, y0 + r - y, (x1 - r + x) - (x0 + r - x), index);
+            hline(x0 + r - x, y1 - r + y, (x1 - r + x) - (x0 + r - x), index);
+            hline(x0 + r - y, y1 - r + x, (x1 - r + y) - (x0 + r - y), index);
+        }
+
+        fill_rectangle(x0, y0 + r, x1, y1 - r, index);
+    }
+
+    /* Mirrors hagl_fill_circle(). */
+    constexpr void
+    fill_circle(int16_t x0, int16_t y0, int16_t r, uint8_t index)
+    {
+        int16_t x = 0;
+        int16_t y = r;
+        int16_t d = 3 - 2 * r;
+
+        while (y >= x) {
+            hline(x0 - x, y0 + y, x * 2, index);
+            hline(x0 - x, y0 - y, x * 2, index);
+            hline(x0 - y, y0 + x, y * 2, index);
+            hline(x0 - y, y0 - x, y * 2, index);
+
+            if (d <= 0) {
+                d = d + 4 * x + 6;
+                x++;
+            } else {
+                d = d + 4 * (x - y) + 10;
+                x++;
+                y--;
+            }
+        }
+    }
+
+    /* Number of bytes needed for the run length encoded pixels. */
+    constexpr size_t
+    runs_size() const
+    {
+        size_t size = 0;
+        size_t i = 0;
+        while (i < W * H) {
+            size_t count = 1;
+            while (i + count < W * H && count < 255 && pixels[i + count] == pixels[i]) {
+                count++;
+            }
+            size += 2;
+            i += count;
+        }
+        return size;
+    }
+};
+
+/**
+ * Run length encode a canvas at compile time
+ *
+ * Usage: constexpr auto runs = hagl::sprite_runs<canvas>();
+ */
+template <auto Canvas>
+constexpr std::array<uint8_t, Canvas.runs_size()>
+sprite_runs()
+{
+    std::array<uint8_t, Canvas.runs_size()> runs{};
+    size_t out = 0;
+    size_t i = 0;
+    while (i < Canvas.width * Canvas.height) {
+        size_t count = 1;
+        while (i + count < Canvas.width * Canvas.height && count < 255 &&
+               Canvas.pixels[i + count] == Canvas.pixels[i]) {
+            count++;
+        }
+        runs[out++] = count;
+        runs[out++] = Canvas.pixels[i];
+        i += count;
+    }
+    return runs;
+}
+
+template <auto Canvas, size_t N>
+constexpr hagl_sprite_t
+sprite(const std::array<uint8_t, N> &runs, const hagl_color_t *palette)
+{
+    return {Canvas.width, Canvas.height, palette, runs.data(), N};
+}
+
+} // namespace hagl
+
+#endif /* _HAGL_SPRITE_H */
@@ -0,0 +1,47 @@
+/*
+
+This file is part of the HAGL graphics library:
+https://github.com/tuupola/hagl
+
+SPDX-License-Identifier: MIT
+
+*/
+
+#ifndef _HAGL_SURFACE_H
+#define _HAGL_SURFACE_H
+
+#include <stdint.h>
+
+#include <concepts>
+
+#include "hagl/bitmap.h"
+#include "hagl/color.h"
+#include "hagl/window.h"
+
+namespace hagl
+{
+
+/**
+ * Anything the primitives can draw on
+ *
+ * The primitives do all clipping against the public clip window and
+ * then call the raw operations, which may assume their arguments are
+ * inside it. Primitives are templates on this concept, so every call
+ * is resolved and inlined at compile time.
+ */
+template <typename S>
+concept Surface = requires(S &surface, int16_t x, int16_t y, uint16_t length,
+    hagl_color_t color, hagl_bitmap_t *bitmap) {
+    { surface.clip } -> std::convertible_to<hagl_window_t>;
+    { surface.width } -> std::convertible_to<int16_t>;
+    { surface.height } -> std::convertible_to<int16_t>;
+    { surface.depth } -> std::convertible_to<uint8_t>;
+    surface.put_pixel(x, y, color);
+    surface.drawHlineInner(x, y, length, color);
+    surface.drawVlineInner(x, y, length, color);
+    surface.blit(x, y, bitmap);
+};
+
+} // namespace hagl
+
+#endif /* _HAGL_SURFACE_H */
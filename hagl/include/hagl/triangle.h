@@ -38,6 +38,8 @@ SPDX-License-Identifier: MIT
 #include <stdint.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/polygon.h"
 
 
 
@@ -56,8 +58,13 @@ SPDX-License-Identifier: MIT
  * @param y3
  * @param color
  */
+template <hagl::Surface S>
 void
-hagl_draw_triangle(Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, hagl_color_t color);
+hagl_draw_triangle(S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, hagl_color_t color)
+{
+    int16_t vertices[6] = {x0, y0, x1, y1, x2, y2};
+    hagl_draw_polygon(display, 3, vertices, color);
+}
 
 /**
  * Draw a filled triangle
@@ -74,8 +81,13 @@ hagl_draw_triangle(Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t
  * @param y3
  * @param color
  */
+template <hagl::Surface S>
 void
-hagl_fill_triangle(Display& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, hagl_color_t color);
+hagl_fill_triangle(S& display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, hagl_color_t color)
+{
+    int16_t vertices[6] = {x0, y0, x1, y1, x2, y2};
+    hagl_fill_polygon(display, 3, vertices, color);
+}
 
 
 #endif /* _HAGL_TRIANGLE_H */
\ No newline at end of file
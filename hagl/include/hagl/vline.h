@@ -39,6 +39,8 @@ SPDX-License-Identifier: MIT
 #include <stdlib.h>
 
 #include "hagl/color.h"
+#include "hagl/surface.h"
+#include "hagl/pixel.h"
 
 
 
@@ -53,8 +55,34 @@ SPDX-License-Identifier: MIT
  * @param height
  * @param color
  */
-void
-hagl_draw_vline_xyh(Display& display, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color);
+template <hagl::Surface S>
+void hagl_draw_vline_xyh(S& display, int16_t x0, int16_t y0, uint16_t h, hagl_color_t color)
+{
+    int16_t height = h;
+
+    /* x0 or y0 is over the edge, nothing to do. */
+    if ((x0 > display.clip.x1) || (x0 < display.clip.x0) || (y0 > display.clip.y1)) {
+        return;
+    }
+
+    /* y0 is top of clip window, ignore start part. */
+    if (y0 < display.clip.y0) {
+        height = height + y0;
+        y0 = display.clip.y0;
+    }
+
+    /* Everything outside clip window, nothing to do. */
+    if (height <= 0) {
+        return;
+    }
+
+    /* Cut anything going over right edge. */
+    if (((y0 + height) > display.clip.y1)) {
+        height = height - (y0 + height - 1 - display.clip.y1);
+    }
+
+    display.drawVlineInner(x0, y0, height, color);
+}
 
 /**
  * Draw a vertical line
@@ -67,8 +95,9 @@ hagl_draw_vline_xyh(Display& display, int16_t x0, int16_t y0, uint16_t height, h
  * @param y1
  * @param color
  */
-static inline void
-hagl_draw_vline_xyy(Display& display, int16_t x0, int16_t y0, int16_t y1, hagl_color_t color)
+template <hagl::Surface S>
+inline void
+hagl_draw_vline_xyy(S& display, int16_t x0, int16_t y0, int16_t y1, hagl_color_t color)
 {
     hagl_draw_vline_xyh(display, x0, y0, abs(y1 - y0) + 1, color);
 }
@@ -84,8 +113,9 @@ hagl_draw_vline_xyy(Display& display, int16_t x0, int16_t y0, int16_t y1, hagl_c
  * @param height
  * @param color
  */
-static inline void
-hagl_draw_vline(Display& display, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+template <hagl::Surface S>
+inline void
+hagl_draw_vline(S& display, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
 {
     hagl_draw_vline_xyh(display, x0, y0, height, color);
 }
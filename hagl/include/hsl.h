@@ -44,8 +44,22 @@ typedef struct {
 } hsl_t;
 
 #include "rgb888.h"
+#include "hagl_hal_color.h"
 
 rgb_t hsl_to_rgb888(hsl_t *hsl);
 
+/**
+ * Convert HSL to RGB565 using integer math only
+ *
+ * Uses the same 0...255 scale as hsl_t. Each RGB565 component is
+ * within one step of what hsl_to_rgb888() gives.
+ *
+ * @param h hue
+ * @param s saturation
+ * @param l lightness
+ * @return color
+ */
+hagl_color_t hsl_to_rgb565(uint8_t h, uint8_t s, uint8_t l);
+
 
 #endif /* _HSL_H */
@@ -3,6 +3,7 @@
 #include "Components/Button.h"
 #include "Utils/TCP.h"
 #include "Utils/Comm.h"
+#include "Utils/Rpc.h"
 #include "Utils/Logger.h"
 #include "Functions/Snake.h"
 #include "Functions/PerfGraph.h"
@@ -17,6 +18,7 @@
 #include <pico/stdlib.h>
 #include <pico/binary_info.h>
 #include <pico/multicore.h>
+#include <pico/flash.h>
 #include <hardware/spi.h>
 
 #include <iostream>
@@ -146,7 +148,12 @@ void displayThread()
     Display cpuDisplay(14, 11, 6, 7, spi1);
     Display display2(14, 11, 17, 16, spi1);
 
-    mini_lcd::System system;
+    // About 60 KB of history and layer pixels, far more than the 2 KB stack of core1, so it is
+    // static. Constructed here rather than at startup so the encoder and button interrupts are
+    // set up on this core.
+    static mini_lcd::System system;
+    // What stays on the stack.
+    static_assert(4 * sizeof(Display) + sizeof(mini_lcd::Receiver) < 512);
 
     mipi_display_spi_master_init();
 
@@ -176,16 +183,44 @@ void displayThread()
 void mainThread()
 {
     Timestamp lastTime = millis();
-    mini_lcd::TCPTest tcp;
+    Timestamp pollInterval = 5000;
+    // Both hold whole messages, together close to the 2 KB stack of core0 which interrupts share.
+    static mini_lcd::TCPTest tcp;
     while (!tcp.Connect())
         ;
 
+    // Requests from the Settings menu on core1.
+    static mini_lcd::RpcServer rpc;
+    rpc.Handle(mini_lcd::Message::Type::SetPollInterval, [&](const mini_lcd::Message& request) {
+        pollInterval = request.data[mini_lcd::Message::Argument];
+        return mini_lcd::RpcStatus::Ok;
+    });
+    // Joining takes seconds, the request is answered from the loop once it is done.
+    uint32_t reconnectId = 0;
+    rpc.Handle(mini_lcd::Message::Type::Reconnect, [&](const mini_lcd::Message& request) {
+        if (reconnectId) {
+            return mini_lcd::RpcStatus::Failed;
+        }
+        reconnectId = request.data[mini_lcd::Message::RequestId];
+        tcp.StartJoin();
+        return mini_lcd::RpcStatus::Pending;
+    });
+
     while (1) {
         Timestamp currentTime = millis();
-        if (currentTime - lastTime > 5000) {
+        if (reconnectId) {
+            auto join = tcp.PollJoin();
+            if (join != mini_lcd::TCPTest::Join::InProgress) {
+                rpc.Complete(reconnectId, join == mini_lcd::TCPTest::Join::Up
+                        ? mini_lcd::RpcStatus::Ok
+                        : mini_lcd::RpcStatus::Failed);
+                reconnectId = 0;
+            }
+        } else if (currentTime - lastTime > pollInterval) {
             lastTime = currentTime;
             tcp.GetMeasurements();
         }
+        rpc.Process();
         mini_lcd::Sender::GetInstance().Process();
     }
 }
@@ -195,6 +230,9 @@ int main()
     stdio_init_all();
     sleep_ms(2000);
     Logger::info() << "Start!\n";
+    // Core1 persists history to flash and may do so as soon as it runs, this core has to be
+    // ready to be parked while a sector is written before core1 is launched.
+    flash_safe_execute_core_init();
     multicore_launch_core1(displayThread);
     mainThread();
 }
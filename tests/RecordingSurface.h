@@ -0,0 +1,133 @@
+#pragma once
+
+#include "hagl/bitmap.h"
+#include "hagl/color.h"
+#include "hagl/sprite.h"
+#include "hagl/window.h"
+
+#include <cstdint>
+#include <cstring>
+
+// Surface for the host tests. Keeps the pixels like Bitmap does, counts the raw operations the
+// primitives call and every pixel they touch outside the clip window, which the primitives
+// promise never to do. Bitmap itself needs hagl_hal.h and with it the Pico SDK.
+template <uint16_t W, uint16_t H>
+class RecordingSurface
+{
+public:
+    static constexpr int16_t width = W;
+    static constexpr int16_t height = H;
+    static constexpr uint8_t depth = 16;
+    hagl_window_t clip{0, 0, W - 1, H - 1};
+
+    struct Counts
+    {
+        uint32_t pixels = 0;
+        uint32_t hlines = 0;
+        uint32_t vlines = 0;
+        uint32_t blits = 0;
+        uint32_t sprites = 0;
+        // Every pixel written, the same pixel twice counts twice.
+        uint32_t written = 0;
+        // Pixels written outside the clip window.
+        uint32_t outside = 0;
+    };
+
+    void put_pixel(int16_t x0, int16_t y0, hagl_color_t color)
+    {
+        ++counts_.pixels;
+        write(x0, y0, color);
+    }
+
+    void drawHlineInner(int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+    {
+        ++counts_.hlines;
+        for (uint16_t x = 0; x < width; ++x) {
+            write(x0 + x, y0, color);
+        }
+    }
+
+    void drawVlineInner(int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+    {
+        ++counts_.vlines;
+        for (uint16_t y = 0; y < height; ++y) {
+            write(x0, y0 + y, color);
+        }
+    }
+
+    void blit(int16_t x0, int16_t y0, hagl_bitmap_t* src)
+    {
+        ++counts_.blits;
+        const uint8_t* row = src->buffer;
+        for (uint16_t y = 0; y < src->height; ++y) {
+            for (uint16_t x = 0; x < src->width; ++x) {
+                hagl_color_t color;
+                std::memcpy(&color, row + x * sizeof(hagl_color_t), sizeof(color));
+                write(x0 + x, y0 + y, color);
+            }
+            row += src->pitch;
+        }
+    }
+
+    // Decodes the runs like Display does while streaming them, so hagl_blit_sprite() takes its one
+    // window path here as well.
+    void sprite(int16_t x0, int16_t y0, const hagl_sprite_t* sprite)
+    {
+        ++counts_.sprites;
+        uint32_t pixel = 0;
+        for (uint16_t i = 0; i < sprite->size; i += 2) {
+            hagl_color_t color = sprite->palette[sprite->runs[i + 1]];
+            for (uint8_t n = 0; n < sprite->runs[i]; ++n, ++pixel) {
+                write(x0 + pixel % sprite->width, y0 + pixel / sprite->width, color);
+            }
+        }
+    }
+
+    hagl_color_t at(int16_t x, int16_t y) const
+    {
+        return pixels_[y * W + x];
+    }
+
+    // Pixels of the given colour in the rectangle, both corners inclusive.
+    uint32_t count(hagl_color_t color, int16_t x0 = 0, int16_t y0 = 0, int16_t x1 = W - 1,
+        int16_t y1 = H - 1) const
+    {
+        uint32_t found = 0;
+        for (int16_t y = y0; y <= y1; ++y) {
+            for (int16_t x = x0; x <= x1; ++x) {
+                found += at(x, y) == color;
+            }
+        }
+        return found;
+    }
+
+    const Counts& counts() const
+    {
+        return counts_;
+    }
+
+    void reset(hagl_color_t color = 0)
+    {
+        for (hagl_color_t& pixel : pixels_) {
+            pixel = color;
+        }
+        counts_ = {};
+    }
+
+private:
+    void write(int32_t x, int32_t y, hagl_color_t color)
+    {
+        ++counts_.written;
+        if (x < clip.x0 || y < clip.y0 || x > clip.x1 || y > clip.y1) {
+            ++counts_.outside;
+            // Off the surface too, dropped rather than written past the end of the buffer.
+            if (x < 0 || y < 0 || x >= W || y >= H) {
+                return;
+            }
+        }
+        pixels_[y * W + x] = color;
+    }
+
+    hagl_color_t pixels_[W * H]{};
+    Counts counts_;
+};
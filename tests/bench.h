@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+// Mean nanoseconds per call of f(i) for i in 0...calls - 1, best of a few rounds so a scheduler
+// hiccup does not count. The results are summed into sink so the calls cannot be dropped.
+template <typename F>
+double nanosPerCall(uint32_t calls, uint32_t& sink, F&& f)
+{
+    using Clock = std::chrono::steady_clock;
+    double best = 0;
+    for (int round = 0; round < 5; ++round) {
+        auto start = Clock::now();
+        for (uint32_t i = 0; i < calls; ++i) {
+            sink += f(i);
+        }
+        double nanos = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (round == 0 || nanos < best) {
+            best = nanos;
+        }
+    }
+    return best / calls;
+}
@@ -0,0 +1,248 @@
+#include "bench.h"
+#include "check.h"
+
+#include "hagl/bitmap.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+constexpr uint16_t kWidth = 128;
+constexpr uint16_t kHeight = 160;
+constexpr uint8_t kDepth = 16;
+
+// Per-pixel kernels the bitmap backend used before, for the timings. Unclipped, the benchmark
+// stays inside the bitmap.
+namespace previous
+{
+void hline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t width, hagl_color_t color)
+{
+    hagl_color_t* ptr =
+        (hagl_color_t*)(bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0);
+    for (uint16_t x = 0; x < width; x++) {
+        *ptr++ = color;
+    }
+}
+
+void vline(hagl_bitmap_t* bitmap, int16_t x0, int16_t y0, uint16_t height, hagl_color_t color)
+{
+    hagl_color_t* ptr =
+        (hagl_color_t*)(bitmap->buffer + bitmap->pitch * y0 + (bitmap->depth / 8) * x0);
+    for (uint16_t y = 0; y < height; y++) {
+        *ptr = color;
+        ptr += bitmap->pitch / (bitmap->depth / 8);
+    }
+}
+
+void blit(hagl_bitmap_t* dst, int16_t x0, int16_t y0, hagl_bitmap_t* src)
+{
+    uint8_t* dstptr = dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0;
+    uint8_t* srcptr = src->buffer;
+    uint8_t bytes = dst->depth / 8;
+    for (uint16_t y = 0; y < src->height; y++) {
+        for (uint16_t x = 0; x < src->width; x++) {
+            for (uint16_t z = 0; z < bytes; z++) {
+                *(dstptr++) = *(srcptr++);
+            }
+        }
+        dstptr += (dst->pitch / bytes - src->width) * bytes;
+    }
+}
+
+// Only correct for sources of up to 256 pixels, the index was truncated to a byte.
+void scale_blit(hagl_bitmap_t* dst, int16_t x0, int16_t y0, uint16_t dstw, uint16_t dsth,
+    hagl_bitmap_t* src)
+{
+    uint16_t srcw = src->width;
+    uint32_t x_ratio = (uint32_t)((srcw << 16) / dstw);
+    uint32_t y_ratio = (uint32_t)((src->height << 16) / dsth);
+    uint16_t* dstptr = (uint16_t*)(dst->buffer + dst->pitch * y0 + (dst->depth / 8) * x0);
+    uint16_t* srcptr = (uint16_t*)src->buffer;
+    for (uint16_t y = 0; y < dsth; y++) {
+        for (uint16_t x = 0; x < dstw; x++) {
+            uint16_t px = ((x * x_ratio) >> 16);
+            uint16_t py = ((y * y_ratio) >> 16);
+            *(dstptr++) = srcptr[(uint8_t)((py * srcw) + px)];
+        }
+        dstptr += dst->pitch / (dst->depth / 8) - dstw;
+    }
+}
+} // namespace previous
+
+struct Surface
+{
+    Surface(uint16_t width, uint16_t height)
+        : pixels(width * height)
+    {
+        hagl_bitmap_init(&bitmap, width, height, kDepth, pixels.data());
+    }
+
+    hagl_color_t at(int x, int y) const
+    {
+        return pixels[y * bitmap.width + x];
+    }
+
+    std::vector<hagl_color_t> pixels;
+    hagl_bitmap_t bitmap;
+};
+
+void pattern(Surface& surface)
+{
+    for (size_t i = 0; i < surface.pixels.size(); ++i) {
+        surface.pixels[i] = static_cast<hagl_color_t>(i * 2654435761u >> 16);
+    }
+}
+
+// Every width at every alignment, nothing outside the run is touched.
+void hlineMatches()
+{
+    Surface surface(kWidth, 4);
+    for (int x0 = 0; x0 < 4; ++x0) {
+        for (int width = 0; x0 + width <= kWidth; ++width) {
+            std::fill(surface.pixels.begin(), surface.pixels.end(), 0);
+            surface.bitmap.hline(&surface.bitmap, x0, 1, width, 0xabcd);
+            for (int y = 0; y < 4; ++y) {
+                for (int x = 0; x < kWidth; ++x) {
+                    bool inside = y == 1 && x >= x0 && x < x0 + width;
+                    CHECK(surface.at(x, y) == (inside ? 0xabcd : 0));
+                }
+            }
+        }
+    }
+}
+
+void vlineMatches()
+{
+    Surface surface(8, 16);
+    for (int height = 0; height <= 15; ++height) {
+        std::fill(surface.pixels.begin(), surface.pixels.end(), 0);
+        surface.bitmap.vline(&surface.bitmap, 3, 1, height, 0x1234);
+        for (int y = 0; y < 16; ++y) {
+            for (int x = 0; x < 8; ++x) {
+                bool inside = x == 3 && y >= 1 && y < 1 + height;
+                CHECK(surface.at(x, y) == (inside ? 0x1234 : 0));
+            }
+        }
+    }
+}
+
+// Clipped on every side, pixel by pixel against the source.
+void blitMatches()
+{
+    Surface src(20, 12);
+    pattern(src);
+    Surface dst(32, 24);
+    for (int y0 = -14; y0 <= 26; y0 += 5) {
+        for (int x0 = -22; x0 <= 34; x0 += 7) {
+            std::fill(dst.pixels.begin(), dst.pixels.end(), 0);
+            dst.bitmap.blit(&dst.bitmap, x0, y0, &src.bitmap);
+            for (int y = 0; y < 24; ++y) {
+                for (int x = 0; x < 32; ++x) {
+                    int sx = x - x0;
+                    int sy = y - y0;
+                    bool inside = sx >= 0 && sx < 20 && sy >= 0 && sy < 12;
+                    CHECK(dst.at(x, y) == (inside ? src.at(sx, sy) : 0));
+                }
+            }
+        }
+    }
+}
+
+// Nearest neighbour from a source wider than 255 pixels, also clipped on the left and top.
+void scaleBlitMatches()
+{
+    Surface src(300, 10);
+    pattern(src);
+    Surface dst(64, 40);
+    uint16_t w = 90;
+    uint16_t h = 25;
+    uint32_t xr = (300u << 16) / w;
+    uint32_t yr = (10u << 16) / h;
+    for (int y0 : {-7, 0, 20}) {
+        for (int x0 : {-30, 0, 10}) {
+            std::fill(dst.pixels.begin(), dst.pixels.end(), 0);
+            dst.bitmap.scale_blit(&dst.bitmap, x0, y0, w, h, &src.bitmap);
+            for (int y = 0; y < 40; ++y) {
+                for (int x = 0; x < 64; ++x) {
+                    int dx = x - x0;
+                    int dy = y - y0;
+                    bool inside = dx >= 0 && dx < w && dy >= 0 && dy < h;
+                    CHECK(dst.at(x, y) ==
+                        (inside ? src.at((dx * xr) >> 16, (dy * yr) >> 16) : 0));
+                }
+            }
+        }
+    }
+}
+} // namespace
+
+int main()
+{
+    hlineMatches();
+    vlineMatches();
+    blitMatches();
+    scaleBlitMatches();
+
+    Surface screen(kWidth, kHeight);
+    Surface tile(64, 64);
+    Surface full(kWidth, kHeight);
+    Surface icon(16, 16);
+    pattern(tile);
+    pattern(full);
+    pattern(icon);
+    // Both sets of kernels are called through the function pointers, as hagl does.
+    hagl_bitmap_t* dst = &screen.bitmap;
+    hagl_bitmap_t before = screen.bitmap;
+    before.hline = previous::hline;
+    before.vline = previous::vline;
+    before.blit = previous::blit;
+    before.scale_blit = previous::scale_blit;
+    hagl_bitmap_t* old = &before;
+    uint32_t sink = 0;
+    constexpr uint32_t kCalls = 2000;
+
+    auto time = [&](auto&& draw) {
+        return nanosPerCall(kCalls, sink, [&](uint32_t i) {
+            draw(static_cast<hagl_color_t>(i));
+            return screen.pixels[i % screen.pixels.size()];
+        }) / 1000;
+    };
+
+    std::printf("%dx%d RGB565 bitmap, us per operation\n", kWidth, kHeight);
+    std::printf("                           before   after\n");
+    std::printf("  fill with hlines        %7.2f %7.2f\n", time([&](hagl_color_t color) {
+        for (int16_t y = 0; y < kHeight; ++y) {
+            old->hline(old, 0, y, kWidth, color);
+        }
+    }),
+        time([&](hagl_color_t color) {
+            for (int16_t y = 0; y < kHeight; ++y) {
+                dst->hline(dst, 0, y, kWidth, color);
+            }
+        }));
+    std::printf("  fill with vlines        %7.2f %7.2f\n", time([&](hagl_color_t color) {
+        for (int16_t x = 0; x < kWidth; ++x) {
+            old->vline(old, x, 0, kHeight, color);
+        }
+    }),
+        time([&](hagl_color_t color) {
+            for (int16_t x = 0; x < kWidth; ++x) {
+                dst->vline(dst, x, 0, kHeight, color);
+            }
+        }));
+    std::printf("  blit 64x64              %7.2f %7.2f\n",
+        time([&](hagl_color_t) { old->blit(old, 10, 10, &tile.bitmap); }),
+        time([&](hagl_color_t) { dst->blit(dst, 10, 10, &tile.bitmap); }));
+    std::printf("  blit full screen        %7.2f %7.2f\n",
+        time([&](hagl_color_t) { old->blit(old, 0, 0, &full.bitmap); }),
+        time([&](hagl_color_t) { dst->blit(dst, 0, 0, &full.bitmap); }));
+    std::printf("  scale 16x16 to 128x128  %7.2f %7.2f\n",
+        time([&](hagl_color_t) { old->scale_blit(old, 0, 0, 128, 128, &icon.bitmap); }),
+        time([&](hagl_color_t) { dst->scale_blit(dst, 0, 0, 128, 128, &icon.bitmap); }));
+    std::printf("(checksum %u)\n", sink);
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "bench.h"
+#include "check.h"
+
+#include "hagl/gradient.h"
+#include "hsl.h"
+#include "rgb565.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+constexpr uint32_t kCalls = 1 << 20;
+
+// The conversion hsl_to_rgb565() replaces, through the floating point RGB888 path.
+hagl_color_t floatHsl(uint8_t h, uint8_t s, uint8_t l)
+{
+    hsl_t hsl = {static_cast<double>(h), static_cast<double>(s), static_cast<double>(l)};
+    rgb_t rgb = hsl_to_rgb888(&hsl);
+    return rgb565(rgb.r, rgb.g, rgb.b);
+}
+
+// Colours are in display byte order.
+void components(hagl_color_t color, int& r, int& g, int& b)
+{
+    uint16_t rgb = static_cast<uint16_t>((color << 8) | (color >> 8));
+    r = rgb >> 11;
+    g = (rgb >> 5) & 0x3f;
+    b = rgb & 0x1f;
+}
+
+// Every hue on a grid of saturation and lightness is within one step of the float conversion.
+void matchesFloat()
+{
+    for (int h = 0; h < 256; ++h) {
+        for (int s = 0; s < 256; s += 51) {
+            for (int l = 0; l < 256; l += 51) {
+                int r0, g0, b0, r1, g1, b1;
+                components(floatHsl(h, s, l), r0, g0, b0);
+                components(hsl_to_rgb565(h, s, l), r1, g1, b1);
+                CHECK(std::abs(r0 - r1) <= 1 && std::abs(g0 - g1) <= 1 && std::abs(b0 - b1) <= 1);
+            }
+        }
+    }
+}
+
+void gradientEnds()
+{
+    hagl_gradient_t gradient;
+    hagl_gradient_hsl(&gradient, 170, 0, 255, 128);
+    CHECK(hagl_gradient_color(&gradient, 0) == hsl_to_rgb565(170, 255, 128));
+    CHECK(hagl_gradient_color(&gradient, 100) == hsl_to_rgb565(0, 255, 128));
+    CHECK(hagl_gradient_color(&gradient, 200) == hagl_gradient_color(&gradient, 100));
+}
+} // namespace
+
+int main()
+{
+    matchesFloat();
+    gradientEnds();
+
+    // Inputs the compiler cannot see through.
+    static uint8_t values[256];
+    for (int i = 0; i < 256; ++i) {
+        values[i] = static_cast<uint8_t>(std::rand());
+    }
+    uint32_t sink = 0;
+
+    double floatNs = nanosPerCall(kCalls, sink, [](uint32_t i) {
+        return floatHsl(values[i & 255], 255, values[(i >> 8) & 255]);
+    });
+    double integerNs = nanosPerCall(kCalls, sink, [](uint32_t i) {
+        return hsl_to_rgb565(values[i & 255], 255, values[(i >> 8) & 255]);
+    });
+
+    // Colour of a load value as the heatmap needs it, converted per cell or looked up.
+    hagl_gradient_t gradient;
+    hagl_gradient_hsl(&gradient, 170, 0, 255, 128);
+    double perCellNs = nanosPerCall(kCalls, sink, [](uint32_t i) {
+        uint8_t percent = values[i & 255] % 101;
+        return floatHsl(170 - 170 * percent / 100, 255, 128);
+    });
+    double lookupNs = nanosPerCall(kCalls, sink, [&](uint32_t i) {
+        return hagl_gradient_color(&gradient, values[i & 255] % 101);
+    });
+
+    std::printf("HSL to RGB565, ns per colour (checksum %u)\n", sink);
+    std::printf("  float via RGB888:  %6.2f\n", floatNs);
+    std::printf("  integer:           %6.2f\n", integerNs);
+    std::printf("Load to heatmap colour\n");
+    std::printf("  float HSL per cell: %6.2f\n", perCellNs);
+    std::printf("  gradient lookup:    %6.2f\n", lookupNs);
+    return 0;
+}
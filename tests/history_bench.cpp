@@ -0,0 +1,185 @@
+#include "bench.h"
+#include "check.h"
+
+#include "Utils/HistoryBlock.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using mini_lcd::CompressedHistory;
+using mini_lcd::HistoryBlock;
+
+namespace
+{
+constexpr uint8_t kGroups = 16;
+// Timestamp plus one byte per group.
+constexpr size_t kRawFrame = sizeof(uint32_t) + kGroups;
+
+struct Frame
+{
+    uint32_t seconds;
+    std::array<uint8_t, kGroups> groups;
+};
+
+struct Sample
+{
+    uint32_t seconds;
+    uint8_t load;
+};
+
+std::vector<Sample> load(const char* path)
+{
+    std::vector<Sample> samples;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        uint32_t seconds;
+        int value;
+        char comma;
+        if (fields >> seconds >> comma >> value) {
+            samples.push_back({seconds, static_cast<uint8_t>(std::clamp(value, 0, 100))});
+        }
+    }
+    return samples;
+}
+
+// The recording has one core, PerfGraph spreads it over every group the same way.
+std::vector<Frame> oneCore(const std::vector<Sample>& samples)
+{
+    std::vector<Frame> frames;
+    for (const auto& sample : samples) {
+        Frame frame{sample.seconds, {}};
+        frame.groups.fill(sample.load);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Means over the default 5 s poll interval of the firmware.
+std::vector<Sample> average(const std::vector<Sample>& samples, size_t count)
+{
+    std::vector<Sample> means;
+    for (size_t i = 0; i + count <= samples.size(); i += count) {
+        uint32_t sum = 0;
+        for (size_t j = i; j < i + count; ++j) {
+            sum += samples[j].load;
+        }
+        means.push_back({samples[i + count - 1].seconds, static_cast<uint8_t>(sum / count)});
+    }
+    return means;
+}
+
+// Sixteen groups that move independently, each one replays its own stretch of the recording.
+std::vector<Frame> sixteenStretches(const std::vector<Sample>& samples)
+{
+    std::vector<Frame> frames;
+    size_t length = samples.size() / kGroups;
+    for (size_t i = 0; i < length; ++i) {
+        Frame frame{samples[i].seconds, {}};
+        for (size_t group = 0; group < kGroups; ++group) {
+            frame.groups[group] = samples[group * length + i].load;
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Encodes the frames block by block as the ring does, decodes them again and compares.
+double bytesPerFrame(const std::vector<Frame>& frames)
+{
+    std::vector<HistoryBlock> blocks(1);
+    blocks.back().Reset(kGroups);
+    for (const auto& frame : frames) {
+        if (!blocks.back().Append(frame.seconds, frame.groups.data())) {
+            blocks.emplace_back().Reset(kGroups);
+            CHECK(blocks.back().Append(frame.seconds, frame.groups.data()));
+        }
+    }
+
+    size_t bytes = 0;
+    size_t index = 0;
+    uint32_t seconds;
+    std::array<uint8_t, HistoryBlock::kMaxChannels> values;
+    for (const auto& block : blocks) {
+        bytes += block.Bytes();
+        HistoryBlock::Reader reader(block);
+        while (reader.Next(seconds, values.data())) {
+            CHECK(index < frames.size());
+            CHECK(seconds == frames[index].seconds);
+            CHECK(std::equal(
+                frames[index].groups.begin(), frames[index].groups.end(), values.begin()));
+            ++index;
+        }
+    }
+    CHECK(index == frames.size());
+    return static_cast<double>(bytes) / frames.size();
+}
+
+void report(const char* name, const std::vector<Frame>& frames)
+{
+    double perFrame = bytesPerFrame(frames);
+    std::printf("  %-26s %5zu frames %6.2f B/frame, %5.1fx, %5.0f frames in 8 KB\n", name,
+        frames.size(), perFrame, kRawFrame / perFrame, 8 * HistoryBlock::kSize / perFrame);
+}
+
+// The newest frames come back from the ring after the oldest blocks were dropped.
+void ringKeepsNewest(const std::vector<Frame>& frames)
+{
+    CompressedHistory<2> history(kGroups);
+    for (const auto& frame : frames) {
+        history.Append(frame.seconds, frame.groups.data());
+    }
+    size_t count = std::min<size_t>(history.Frames(), 100);
+    size_t index = frames.size() - count;
+    history.ForEachLast(count, [&](uint32_t seconds, const uint8_t* groups) {
+        CHECK(seconds == frames[index].seconds);
+        CHECK(std::equal(groups, groups + kGroups, frames[index].groups.begin()));
+        ++index;
+    });
+    CHECK(index == frames.size());
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    CHECK(argc == 2);
+    auto samples = load(argv[1]);
+    CHECK(samples.size() >= 16 * 32);
+
+    auto recorded = oneCore(samples);
+    auto polled = oneCore(average(samples, 5));
+    auto independent = sixteenStretches(samples);
+    ringKeepsNewest(recorded);
+    ringKeepsNewest(polled);
+    ringKeepsNewest(independent);
+
+    std::printf("%zu samples from %s\n", samples.size(), argv[1]);
+    std::printf("Raw frame %zu B\n", kRawFrame);
+    report("one core in every group", recorded);
+    report("same, 5 s means", polled);
+    report("16 independent stretches", independent);
+
+    uint32_t sink = 0;
+    static HistoryBlock block;
+    auto frames = static_cast<uint32_t>(independent.size());
+    double encodeNs = nanosPerCall(frames, sink, [&](uint32_t i) {
+        const Frame& frame = independent[i];
+        if (i == 0 || !block.Append(frame.seconds, frame.groups.data())) {
+            block.Reset(kGroups);
+            return block.Append(frame.seconds, frame.groups.data());
+        }
+        return true;
+    });
+    std::printf("Encoding a 16 group frame: %.0f ns\n", encodeNs);
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include "check.h"
+
+#include "Utils/HttpResponseParser.h"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using mini_lcd::HttpResponseParser;
+
+namespace
+{
+// Responses as text, [status:body] each.
+struct Recorder
+{
+    Recorder()
+        : parser([this](HttpResponseParser::Event event, std::string_view data) {
+              switch (event) {
+                  case HttpResponseParser::Event::Start:
+                      responses += '[' + std::to_string(parser.Status()) + ':';
+                      break;
+                  case HttpResponseParser::Event::Body:
+                      responses.append(data);
+                      break;
+                  case HttpResponseParser::Event::End:
+                      responses += ']';
+                      break;
+              }
+          })
+    {
+    }
+
+    std::string responses;
+    HttpResponseParser parser;
+};
+
+// Two pipelined responses, one with Content-Length and one chunked with an extension and a
+// trailer, then one that ends the connection. Whatever follows it is not for this connection.
+constexpr std::string_view kStream = "HTTP/1.1 200 OK\r\n"
+                                     "Content-Type: application/json\r\n"
+                                     "content-length:  13\r\n"
+                                     "\r\n"
+                                     "{\"RAM\": 4096}"
+                                     "HTTP/1.1 200 OK\r\n"
+                                     "Transfer-Encoding: chunked\r\n"
+                                     "Content-Length: 3\r\n"
+                                     "\r\n"
+                                     "5\r\n"
+                                     "{\"GPU\r\n"
+                                     "A;name=value\r\n"
+                                     "\": 12, \"x\"\r\n"
+                                     "3\r\n"
+                                     ": 1\r\n"
+                                     "1\r\n"
+                                     "}\r\n"
+                                     "0\r\n"
+                                     "X-Trailer: ignored\r\n"
+                                     "\r\n"
+                                     "HTTP/1.1 503 Service Unavailable\r\n"
+                                     "Connection: close\r\n"
+                                     "Content-Length: 4\r\n"
+                                     "\r\n"
+                                     "busy"
+                                     "HTTP/1.1 200 OK\r\n";
+
+constexpr std::string_view kResponses = "[200:{\"RAM\": 4096}]"
+                                        "[200:{\"GPU\": 12, \"x\": 1}]"
+                                        "[503:busy]";
+
+// Feeds the text in pieces ending at the given offsets, then whatever is left.
+bool feed(Recorder& recorder, std::string_view text, const std::vector<size_t>& splits)
+{
+    size_t start = 0;
+    for (size_t end : splits) {
+        if (!recorder.parser.Feed(text.substr(start, end - start))) {
+            return false;
+        }
+        start = end;
+    }
+    return recorder.parser.Feed(text.substr(start));
+}
+
+void wholeStream()
+{
+    Recorder recorder;
+    CHECK(feed(recorder, kStream, {}));
+    CHECK(recorder.responses == kResponses);
+    CHECK(recorder.parser.Closing());
+    CHECK(recorder.parser.Status() == 503);
+}
+
+// Segments end anywhere, in the status line, a header, a chunk size or the line after a chunk.
+void splitAnywhere()
+{
+    std::vector<size_t> bytes;
+    for (size_t i = 1; i < kStream.size(); ++i) {
+        bytes.push_back(i);
+    }
+    Recorder recorder;
+    CHECK(feed(recorder, kStream, bytes));
+    CHECK(recorder.responses == kResponses);
+    CHECK(recorder.parser.Closing());
+
+    for (size_t split = 0; split <= kStream.size(); ++split) {
+        for (size_t second = split; second <= kStream.size(); second += 7) {
+            Recorder recorder;
+            CHECK(feed(recorder, kStream, {split, second}));
+            CHECK(recorder.responses == kResponses);
+            CHECK(recorder.parser.Closing());
+        }
+    }
+}
+
+// Without a length the body runs until the server closes the connection.
+void untilClosed()
+{
+    Recorder recorder;
+    CHECK(recorder.parser.Feed("HTTP/1.1 200 OK\r\n\r\n{\"a\":"));
+    CHECK(recorder.parser.Feed(" 1}"));
+    CHECK(recorder.responses == "[200:{\"a\": 1}");
+    recorder.parser.Closed();
+    CHECK(recorder.responses == "[200:{\"a\": 1}]");
+    CHECK(recorder.parser.Closing());
+
+    // HTTP/1.0 closes after the response even with a length, a bare line feed ends lines too.
+    recorder.parser.Reset();
+    recorder.responses.clear();
+    CHECK(recorder.parser.Feed("HTTP/1.0 200 OK\nContent-Length: 2\n\nokHTTP/1.0"));
+    CHECK(recorder.responses == "[200:ok]");
+    CHECK(recorder.parser.Closing());
+
+    // Cut off in the middle of a response, nothing ends.
+    recorder.parser.Reset();
+    recorder.responses.clear();
+    CHECK(recorder.parser.Feed("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n12345"));
+    recorder.parser.Closed();
+    CHECK(recorder.responses == "[200:12345");
+    CHECK(!recorder.parser.Closing());
+}
+
+// No body, whatever the headers claim.
+void withoutBody()
+{
+    Recorder recorder;
+    CHECK(recorder.parser.Feed("HTTP/1.1 204 No Content\r\nContent-Length: 5\r\n\r\n"
+                               "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n"));
+    CHECK(recorder.responses == "[204:][200:]");
+    CHECK(!recorder.parser.Closing());
+}
+
+void malformed()
+{
+    const std::string_view streams[] = {
+        "garbage\r\n",
+        "HTTP/1.1 OK\r\n",
+        "HTTP/2 200\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2\r\nabc\r\n",
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: gzip, chunked\r\n\r\n1x\r\n",
+    };
+    for (auto stream : streams) {
+        Recorder recorder;
+        CHECK(!recorder.parser.Feed(stream));
+        CHECK(!recorder.parser.Feed("HTTP/1.1 200 OK\r\n"));
+    }
+
+    // A new connection starts over.
+    Recorder recorder;
+    CHECK(!recorder.parser.Feed("garbage\r\n"));
+    recorder.parser.Reset();
+    CHECK(recorder.parser.Feed(kStream));
+    CHECK(recorder.responses == kResponses);
+}
+} // namespace
+
+int main()
+{
+    wholeStream();
+    splitAnywhere();
+    untilClosed();
+    withoutBody();
+    malformed();
+    std::printf("http_test passed\n");
+    return 0;
+}
@@ -0,0 +1,259 @@
+#include "RecordingSurface.h"
+#include "check.h"
+
+#include "Utils/PbufReader.h"
+#include "hagl/clip.h"
+#include "hagl/image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+using Surface = RecordingSurface<32, 24>;
+
+constexpr uint16_t kBlocksX = 6;
+constexpr uint16_t kBlocksY = 4;
+constexpr hagl_color_t kUntouched = 0x1234;
+
+struct Rgb
+{
+    uint8_t r, g, b;
+};
+
+const Rgb kPalette[] = {
+    {200, 40, 40}, {40, 180, 60}, {30, 60, 200}, {128, 128, 128}, {250, 250, 250}, {10, 10, 10}};
+
+Rgb blockColor(uint16_t bx, uint16_t by)
+{
+    return kPalette[(bx + 2 * by) % std::size(kPalette)];
+}
+
+// Baseline 4:4:4 JPEG in which every 8 x 8 block is one flat colour, so only DC coefficients are
+// coded. Small enough to build here instead of keeping a binary fixture.
+class FlatJpeg
+{
+public:
+    std::vector<uint8_t> Encode()
+    {
+        marker(0xd8);
+
+        // One quantisation table of ones, shared by all components.
+        segment(0xdb, 65);
+        bytes_.push_back(0x00);
+        bytes_.insert(bytes_.end(), 64, 1);
+
+        segment(0xc0, 6 + 3 * 3);
+        bytes_.insert(bytes_.end(), {8, 0, kBlocksY * 8, 0, kBlocksX * 8, 3});
+        for (uint8_t id = 1; id <= 3; ++id) {
+            bytes_.insert(bytes_.end(), {id, 0x11, 0x00});
+        }
+
+        // The decoder wants tables 0 for luma and 1 for chroma. Both get the standard DC table and
+        // an AC table holding nothing but end of block.
+        for (uint8_t table = 0; table < 2; ++table) {
+            segment(0xc4, 1 + 16 + 12);
+            bytes_.push_back(0x00 | table);
+            bytes_.insert(bytes_.end(), std::begin(kDcBits), std::end(kDcBits));
+            for (uint8_t category = 0; category < 12; ++category) {
+                bytes_.push_back(category);
+            }
+            segment(0xc4, 1 + 16 + 1);
+            bytes_.push_back(0x10 | table);
+            bytes_.push_back(1);
+            bytes_.insert(bytes_.end(), 15, 0);
+            bytes_.push_back(0x00);
+        }
+
+        segment(0xda, 10);
+        bytes_.insert(bytes_.end(), {3, 1, 0x00, 2, 0x11, 3, 0x11, 0, 63, 0});
+
+        int previous[3] = {0, 0, 0};
+        for (uint16_t by = 0; by < kBlocksY; ++by) {
+            for (uint16_t bx = 0; bx < kBlocksX; ++bx) {
+                Rgb c = blockColor(bx, by);
+                double y = 0.299 * c.r + 0.587 * c.g + 0.114 * c.b;
+                double cb = 128 - 0.168736 * c.r - 0.331264 * c.g + 0.5 * c.b;
+                double cr = 128 + 0.5 * c.r - 0.418688 * c.g - 0.081312 * c.b;
+                const double samples[3] = {y, cb, cr};
+                for (int i = 0; i < 3; ++i) {
+                    // A flat block of value v has DC 8 * (v - 128).
+                    int value = (int)std::lround(8 * (samples[i] - 128));
+                    dc(value - previous[i]);
+                    previous[i] = value;
+                    // End of block.
+                    bits(0, 1);
+                }
+            }
+        }
+        bits(0x7f, 7);
+        marker(0xd9);
+        return bytes_;
+    }
+
+private:
+    // Code lengths of the DC difference categories 0...11, from the standard table.
+    static constexpr uint8_t kDcBits[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+
+    void marker(uint8_t code)
+    {
+        bytes_.insert(bytes_.end(), {0xff, code});
+    }
+
+    void segment(uint8_t code, uint16_t length)
+    {
+        marker(code);
+        bytes_.push_back((length + 2) >> 8);
+        bytes_.push_back((length + 2) & 0xff);
+    }
+
+    void dc(int diff)
+    {
+        uint8_t category = 0;
+        for (int magnitude = std::abs(diff); magnitude; magnitude >>= 1) {
+            ++category;
+        }
+        // Canonical codes of the standard table.
+        static const uint16_t codes[12] = {
+            0x0, 0x2, 0x3, 0x4, 0x5, 0x6, 0xe, 0x1e, 0x3e, 0x7e, 0xfe, 0x1fe};
+        static const uint8_t lengths[12] = {2, 3, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9};
+        bits(codes[category], lengths[category]);
+        if (category) {
+            bits(diff >= 0 ? diff : diff + (1 << category) - 1, category);
+        }
+    }
+
+    void bits(uint32_t value, uint8_t count)
+    {
+        while (count--) {
+            pending_ = (pending_ << 1) | ((value >> count) & 1);
+            if (++pendingBits_ == 8) {
+                bytes_.push_back(pending_);
+                // A data byte of 0xff is followed by a stuffed zero.
+                if (pending_ == 0xff) {
+                    bytes_.push_back(0x00);
+                }
+                pending_ = 0;
+                pendingBits_ = 0;
+            }
+        }
+    }
+
+    std::vector<uint8_t> bytes_;
+    uint8_t pending_ = 0;
+    uint8_t pendingBits_ = 0;
+};
+
+// Decoded colours are big endian RGB565 like the panel wants them.
+bool near(hagl_color_t pixel, Rgb expected)
+{
+    uint16_t rgb = (uint16_t)((pixel << 8) | (pixel >> 8));
+    int r = (rgb >> 11) << 3;
+    int g = ((rgb >> 5) & 0x3f) << 2;
+    int b = (rgb & 0x1f) << 3;
+    return std::abs(r - expected.r) <= 12 && std::abs(g - expected.g) <= 12 &&
+        std::abs(b - expected.b) <= 12;
+}
+
+// Every pixel of the clip window shows the block of the image under it.
+void checkPixels(const Surface& surface, int16_t x0, int16_t y0)
+{
+    for (int16_t y = surface.clip.y0; y <= surface.clip.y1; ++y) {
+        for (int16_t x = surface.clip.x0; x <= surface.clip.x1; ++x) {
+            int16_t ix = x - x0;
+            int16_t iy = y - y0;
+            if (ix < 0 || iy < 0 || ix >= kBlocksX * 8 || iy >= kBlocksY * 8) {
+                CHECK(surface.at(x, y) == kUntouched);
+            } else {
+                CHECK(near(surface.at(x, y), blockColor(ix / 8, iy / 8)));
+            }
+        }
+    }
+}
+
+// Splits the image into a chain of short segments, with an empty one at the start.
+struct Chain
+{
+    explicit Chain(std::vector<uint8_t>& data)
+    {
+        segments.resize(2 + data.size() / 7);
+        size_t offset = 0;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            uint16_t len = i ? std::min<size_t>(7, data.size() - offset) : 0;
+            segments[i] = {nullptr, data.data() + offset, 0, len};
+            offset += len;
+            if (i) {
+                segments[i - 1].next = &segments[i];
+            }
+        }
+        CHECK(offset == data.size());
+    }
+
+    std::vector<pbuf> segments;
+};
+
+// The image is taller than the surface, decoding stops after the last visible row of blocks.
+void decodeFromMemory(const std::vector<uint8_t>& jpeg)
+{
+    static Surface surface;
+    surface.reset(kUntouched);
+    CHECK(hagl_load_image_memory(surface, 0, 0, jpeg.data(), jpeg.size()) == HAGL_OK);
+    checkPixels(surface, 0, 0);
+    CHECK(surface.counts().blits == Surface::height / 8);
+    CHECK(surface.counts().outside == 0);
+}
+
+// Read straight out of a pbuf chain, clipped on all sides.
+void decodeClipped(std::vector<uint8_t>& jpeg)
+{
+    static Surface surface;
+    surface.reset(kUntouched);
+    Chain chain(jpeg);
+    mini_lcd::PbufReader reader(chain.segments.data());
+    uint32_t result =
+        hagl_load_image_reader(surface, -5, -3, mini_lcd::PbufReader::Reader, &reader);
+    CHECK(result == HAGL_OK);
+    checkPixels(surface, -5, -3);
+    // Rows of blocks at -3, 5, 13 and 21, the last one cut at the bottom.
+    CHECK(surface.counts().blits == 4);
+    CHECK(surface.counts().outside == 0);
+
+    surface.reset(kUntouched);
+    hagl_set_clip(surface, 8, 8, 15, 15);
+    CHECK(hagl_load_image_memory(surface, 2, 4, jpeg.data(), jpeg.size()) == HAGL_OK);
+    checkPixels(surface, 2, 4);
+    CHECK(surface.count(kUntouched) == Surface::width * Surface::height - 8 * 8);
+    CHECK(surface.counts().outside == 0);
+
+    // Nothing visible, the decoder stops after the headers.
+    surface.reset(kUntouched);
+    CHECK(hagl_load_image_memory(surface, 16, 20, jpeg.data(), jpeg.size()) == HAGL_OK);
+    CHECK(surface.counts().blits == 0);
+}
+
+void truncatedStream(const std::vector<uint8_t>& jpeg)
+{
+    static Surface surface;
+    surface.reset(kUntouched);
+    CHECK(hagl_load_image_memory(surface, 0, 0, jpeg.data(), 20) != HAGL_OK);
+    CHECK(surface.counts().blits == 0);
+
+    // Cut inside the scan, what was decoded is still drawn inside the clip window.
+    hagl_load_image_memory(surface, 0, 0, jpeg.data(), jpeg.size() - 20);
+    CHECK(surface.counts().outside == 0);
+}
+} // namespace
+
+int main()
+{
+    std::vector<uint8_t> jpeg = FlatJpeg().Encode();
+    decodeFromMemory(jpeg);
+    decodeClipped(jpeg);
+    truncatedStream(jpeg);
+    std::printf("image_test passed, %zu byte image\n", jpeg.size());
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include "check.h"
+
+#include "Utils/JsonParser.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using mini_lcd::JsonParser;
+
+namespace
+{
+// A document much like the ones the host sends, with a key too long to keep whose value nests,
+// a string too long to keep and escapes.
+constexpr std::string_view kDocument = R"({
+    "cpu": [12, 7.5, -3e2],
+    "a key that is longer than the buffer": {"ignored": [1, {"deep": "x"}], "also": true},
+    "name": "tab\there \"quoted\" \u00e9\u20ac\/",
+    "a string value that does not fit in the buffer": 1,
+    "long": "a string value that does not fit in the buffer",
+    "ok": [true, false, null, {}, []]
+})";
+
+// Every event of the document, in order.
+constexpr std::string_view kEvents = "{ 0 '' ''\n"
+                                     "[ 1 'cpu' ''\n"
+                                     "N 2 '' '12'\n"
+                                     "N 2 '' '7.5'\n"
+                                     "N 2 '' '-3e2'\n"
+                                     "] 1 '' ''\n"
+                                     "S 1 'name' 'tab\there \"quoted\" \xc3\xa9\xe2\x82\xac/'\n"
+                                     "[ 1 'ok' ''\n"
+                                     "L 2 '' 'true'\n"
+                                     "L 2 '' 'false'\n"
+                                     "L 2 '' 'null'\n"
+                                     "{ 2 '' ''\n"
+                                     "} 2 '' ''\n"
+                                     "[ 2 '' ''\n"
+                                     "] 2 '' ''\n"
+                                     "] 1 '' ''\n"
+                                     "} 0 '' ''\n";
+
+// Collects the events as text, one line each.
+struct Recorder
+{
+    Recorder()
+        : parser([this](JsonParser::Event event, int depth, std::string_view key,
+                     std::string_view value) {
+              static const char kinds[] = "{}[]SNL";
+              events += kinds[static_cast<int>(event)];
+              events += ' ' + std::to_string(depth) + " '";
+              events.append(key);
+              events += "' '";
+              events.append(value);
+              events += "'\n";
+          })
+    {
+    }
+
+    std::string events;
+    JsonParser parser;
+};
+
+// Feeds the text in pieces ending at the given offsets, then whatever is left.
+bool feed(Recorder& recorder, std::string_view text, const std::vector<size_t>& splits)
+{
+    size_t start = 0;
+    for (size_t end : splits) {
+        if (!recorder.parser.Feed(text.substr(start, end - start))) {
+            return false;
+        }
+        start = end;
+    }
+    return recorder.parser.Feed(text.substr(start));
+}
+
+void wholeDocument()
+{
+    Recorder recorder;
+    CHECK(feed(recorder, kDocument, {}));
+    CHECK(recorder.parser.Done());
+    CHECK(recorder.events == kEvents);
+}
+
+// A piece may end anywhere, in a key, an escape, a \u sequence or a number.
+void byteAtATime()
+{
+    std::vector<size_t> splits;
+    for (size_t i = 1; i < kDocument.size(); ++i) {
+        splits.push_back(i);
+    }
+    Recorder recorder;
+    CHECK(feed(recorder, kDocument, splits));
+    CHECK(recorder.parser.Done());
+    CHECK(recorder.events == kEvents);
+}
+
+void arbitrarySplits()
+{
+    for (size_t split = 0; split <= kDocument.size(); ++split) {
+        Recorder recorder;
+        CHECK(feed(recorder, kDocument, {split}));
+        CHECK(recorder.parser.Done());
+        CHECK(recorder.events == kEvents);
+    }
+
+    std::srand(1);
+    for (int round = 0; round < 200; ++round) {
+        std::vector<size_t> splits;
+        for (size_t at = std::rand() % 8; at < kDocument.size(); at += std::rand() % 8) {
+            splits.push_back(at);
+        }
+        Recorder recorder;
+        CHECK(feed(recorder, kDocument, splits));
+        CHECK(recorder.events == kEvents);
+    }
+}
+
+// The next document starts from scratch after Reset(), also after a failed one.
+void reset()
+{
+    Recorder recorder;
+    CHECK(!recorder.parser.Feed("{\"a\" 1}"));
+    CHECK(recorder.parser.Failed());
+    CHECK(!recorder.parser.Feed("{}"));
+
+    recorder.parser.Reset();
+    recorder.events.clear();
+    CHECK(recorder.parser.Feed(kDocument));
+    CHECK(recorder.events == kEvents);
+
+    // The skip of the oversized key does not leak into the next document.
+    recorder.parser.Reset();
+    recorder.events.clear();
+    CHECK(recorder.parser.Feed("{\"a key that is longer than the buffer\": [1, "));
+    recorder.parser.Reset();
+    CHECK(recorder.parser.Feed("{\"b\": 2}"));
+    CHECK(recorder.events == "{ 0 '' ''\n{ 0 '' ''\nN 1 'b' '2'\n} 0 '' ''\n");
+}
+
+// A number at the top level is only complete with the character after it.
+void topLevelScalars()
+{
+    Recorder recorder;
+    CHECK(recorder.parser.Feed("42"));
+    CHECK(!recorder.parser.Done());
+    CHECK(recorder.parser.Feed(" "));
+    CHECK(recorder.parser.Done());
+    CHECK(recorder.events == "N 0 '' '42'\n");
+
+    recorder.parser.Reset();
+    recorder.events.clear();
+    CHECK(recorder.parser.Feed("\"\\u0041\""));
+    CHECK(recorder.parser.Done());
+    CHECK(recorder.events == "S 0 '' 'A'\n");
+}
+
+void malformed()
+{
+    const std::string_view documents[] = {
+        "{\"a\": tru}",
+        "{\"a\": nulls}",
+        "{\"a\": 1x}",
+        "{\"a\" 1}",
+        "{a: 1}",
+        "{\"a\": 1,}",
+        "[1, ]",
+        "[1 2]",
+        "[1}",
+        "{\"a\": 1]",
+        "]",
+        "\"bad \\q escape\"",
+        "\"bad \\u12g4 escape\"",
+        "\"raw\nnewline\"",
+        "{} {}",
+        "@",
+    };
+    for (auto document : documents) {
+        Recorder recorder;
+        // Trailing space ends a number at the top level.
+        bool ok = recorder.parser.Feed(document) && recorder.parser.Feed(" ");
+        CHECK(!ok);
+        CHECK(recorder.parser.Failed());
+        CHECK(!recorder.parser.Done());
+    }
+
+    // Nesting deeper than the parser tracks.
+    Recorder recorder;
+    CHECK(recorder.parser.Feed(std::string(JsonParser::kMaxDepth, '[')));
+    CHECK(!recorder.parser.Feed("["));
+    CHECK(recorder.parser.Failed());
+}
+} // namespace
+
+int main()
+{
+    wholeDocument();
+    byteAtATime();
+    arbitrarySplits();
+    reset();
+    topLevelScalars();
+    malformed();
+    std::printf("json_test passed\n");
+    return 0;
+}
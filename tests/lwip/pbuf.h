@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// The fields of lwIP's pbuf that the host tests use, to build chains without the lwIP sources.
+struct pbuf
+{
+    pbuf* next;
+    void* payload;
+    uint16_t tot_len;
+    uint16_t len;
+};
@@ -0,0 +1,150 @@
+#include "RecordingSurface.h"
+#include "check.h"
+
+#include "hagl/arc.h"
+#include "hagl/circle.h"
+#include "hagl/clip.h"
+#include "hagl/hline.h"
+#include "hagl/rectangle.h"
+#include "hagl/sprite.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+using Surface = RecordingSurface<32, 24>;
+
+constexpr hagl_color_t kRed = 0xf800;
+constexpr hagl_color_t kBlue = 0x001f;
+
+void hlineClipped()
+{
+    static Surface surface;
+    hagl_draw_hline_xyw(surface, -10, 5, 100, kRed);
+    CHECK(surface.count(kRed) == Surface::width);
+    CHECK(surface.count(kRed, 0, 5, Surface::width - 1, 5) == Surface::width);
+    CHECK(surface.counts().hlines == 1);
+
+    // Fully outside, no call reaches the surface.
+    hagl_draw_hline_xyw(surface, 0, -1, 10, kBlue);
+    hagl_draw_hline_xyw(surface, 0, Surface::height, 10, kBlue);
+    hagl_draw_hline_xyw(surface, Surface::width, 0, 10, kBlue);
+    hagl_draw_hline_xyw(surface, -10, 0, 10, kBlue);
+    CHECK(surface.counts().hlines == 1);
+    CHECK(surface.counts().outside == 0);
+}
+
+void fillRectangleClipped()
+{
+    static Surface surface;
+    hagl_fill_rectangle_xyxy(surface, -5, -3, 4, 2, kRed);
+    CHECK(surface.count(kRed) == 5 * 3);
+    CHECK(surface.count(kRed, 0, 0, 4, 2) == 5 * 3);
+    CHECK(surface.counts().hlines == 3);
+    CHECK(surface.counts().outside == 0);
+}
+
+// Everything lands inside a clip window smaller than the surface.
+void clipWindow()
+{
+    static Surface surface;
+    hagl_set_clip(surface, 8, 8, 15, 15);
+
+    hagl_fill_rectangle_xyxy(surface, 0, 0, Surface::width - 1, Surface::height - 1, kRed);
+    CHECK(surface.count(kRed) == 8 * 8);
+    CHECK(surface.count(kRed, 8, 8, 15, 15) == 8 * 8);
+
+    surface.reset();
+    hagl_fill_circle(surface, 8, 8, 6, kBlue);
+    hagl_draw_circle(surface, 15, 15, 5, kBlue);
+    hagl_fill_rounded_rectangle_xyxy(surface, 4, 10, 20, 30, 3, kBlue);
+    hagl_draw_rounded_rectangle_xyxy(surface, 4, 4, 12, 20, 3, kBlue);
+    hagl_fill_pie(surface, 12, 12, 10, 45, 300, kBlue);
+    CHECK(surface.count(kBlue) > 0);
+    CHECK(surface.counts().outside == 0);
+}
+
+// Arcs sharing an edge angle cover the pie between them exactly once. The centre is the one
+// exception, every pie gets it.
+void arcsTile()
+{
+    using Square = RecordingSurface<41, 41>;
+    static Square whole;
+    static Square first;
+    static Square rest;
+    hagl_fill_pie(whole, 20, 20, 15, 0, 360, kRed);
+    hagl_fill_pie(first, 20, 20, 15, 0, 90, kRed);
+    hagl_fill_pie(rest, 20, 20, 15, 90, 360, kRed);
+
+    uint32_t covered = 0;
+    for (int16_t y = 0; y < Square::height; ++y) {
+        for (int16_t x = 0; x < Square::width; ++x) {
+            bool inFirst = first.at(x, y) == kRed;
+            bool inRest = rest.at(x, y) == kRed;
+            CHECK(!(inFirst && inRest) || (x == 20 && y == 20));
+            CHECK((whole.at(x, y) == kRed) == (inFirst || inRest));
+            // Angles grow clockwise from the right, the first quarter is below and to the right.
+            if (inFirst) {
+                CHECK(x >= 20 && y >= 20);
+            }
+            covered += inFirst || inRest;
+        }
+    }
+    CHECK(covered > 600);
+
+    static Square ring;
+    hagl_fill_ring(ring, 20, 20, 10, 15, kBlue);
+    CHECK(ring.at(20, 20) != kBlue);
+    CHECK(ring.at(20 + 12, 20) == kBlue);
+    CHECK(ring.at(20, 20 - 12) == kBlue);
+    CHECK(ring.at(20 + 16, 20) != kBlue);
+}
+
+// Runs continue across rows and are cut at every edge of the clip window. Only a sprite fully
+// inside goes to the surface as a whole.
+void spriteClipped()
+{
+    static const hagl_color_t palette[] = {kRed, kBlue};
+    // 4 x 3, the first run covers the top row and the start of the second.
+    static const uint8_t runs[] = {5, 0, 7, 1};
+    static const hagl_sprite_t sprite = {4, 3, palette, runs, sizeof(runs)};
+
+    static Surface surface;
+    hagl_blit_sprite(surface, 10, 10, &sprite);
+    // Fully inside, one window.
+    CHECK(surface.counts().sprites == 1);
+    CHECK(surface.counts().hlines == 0);
+    CHECK(surface.count(kRed) == 5);
+    CHECK(surface.count(kBlue) == 7);
+    CHECK(surface.at(13, 10) == kRed);
+    CHECK(surface.at(10, 11) == kRed);
+    CHECK(surface.at(11, 11) == kBlue);
+    CHECK(surface.at(13, 12) == kBlue);
+
+    surface.reset();
+    hagl_blit_sprite(surface, -2, -1, &sprite);
+    CHECK(surface.count(kRed) + surface.count(kBlue) == 2 * 2);
+    CHECK(surface.at(0, 0) == kBlue);
+    CHECK(surface.at(1, 1) == kBlue);
+    CHECK(surface.counts().sprites == 0);
+
+    surface.reset();
+    hagl_blit_sprite(surface, Surface::width - 1, Surface::height - 2, &sprite);
+    CHECK(surface.count(kRed) + surface.count(kBlue) == 2);
+    CHECK(surface.at(Surface::width - 1, Surface::height - 2) == kRed);
+    CHECK(surface.at(Surface::width - 1, Surface::height - 1) == kRed);
+    CHECK(surface.counts().outside == 0);
+}
+} // namespace
+
+int main()
+{
+    hlineClipped();
+    fillRectangleClipped();
+    clipWindow();
+    arcsTile();
+    spriteClipped();
+    std::printf("primitives_test passed\n");
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "check.h"
+
+#include "Utils/CircleDeq.h"
+#include "Utils/SpscRing.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+using mini_lcd::CircleDeq;
+using mini_lcd::SpscRing;
+
+namespace
+{
+constexpr uint32_t kItems = 1'000'000;
+
+// The indices pass the capacity many times, values come out in order and full and empty are
+// reported at the right moments.
+void circleDeqWraps()
+{
+    CircleDeq<uint32_t, 4> queue;
+    uint32_t value = 0;
+    CHECK(queue.empty());
+    CHECK(!queue.try_pop(value));
+
+    uint32_t next = 0;
+    uint32_t expected = 0;
+    for (int round = 0; round < 100; ++round) {
+        while (queue.try_push(next)) {
+            ++next;
+        }
+        CHECK(queue.size() == 4);
+        CHECK(!queue.try_push(next));
+        for (int i = 0; i < 3; ++i) {
+            CHECK(queue.try_pop(value));
+            CHECK(value == expected++);
+        }
+        CHECK(queue.size() == 1);
+    }
+    while (queue.try_pop(value)) {
+        CHECK(value == expected++);
+    }
+    CHECK(expected == next);
+    CHECK(queue.empty());
+    // Two failed pushes in every round, the one that ends the fill and the checked one.
+    CHECK(queue.overflows() == 200);
+}
+
+void circleDeqBulk()
+{
+    CircleDeq<uint32_t, 8> queue;
+    std::array<uint32_t, 5> in{1, 2, 3, 4, 5};
+    std::array<uint32_t, 8> out{};
+
+    CHECK(queue.push_bulk(in) == 5);
+    CHECK(queue.push_bulk(in) == 3);
+    CHECK(queue.overflows() == 2);
+    CHECK(queue.pop_bulk({out.data(), 6}) == 6);
+    CHECK(out[0] == 1 && out[4] == 5 && out[5] == 1);
+    // Across the wrap of the slots.
+    CHECK(queue.push_bulk(in) == 5);
+    CHECK(queue.pop_bulk(out) == 7);
+    CHECK(out[0] == 2 && out[1] == 3 && out[2] == 1 && out[6] == 5);
+    CHECK(queue.pop_bulk(out) == 0);
+}
+
+void spscRingInPlace()
+{
+    SpscRing<uint32_t, 2> ring;
+    CHECK(ring.Front() == nullptr);
+    for (uint32_t i = 0; i < 10; ++i) {
+        uint32_t* slot = ring.Reserve();
+        CHECK(slot != nullptr);
+        // Reserving again without publishing gives the same slot.
+        CHECK(ring.Reserve() == slot);
+        *slot = i;
+        ring.Publish();
+        CHECK(ring.Front() != nullptr && *ring.Front() == i);
+        ring.Pop();
+        CHECK(ring.Front() == nullptr);
+    }
+    *ring.Reserve() = 1;
+    ring.Publish();
+    *ring.Reserve() = 2;
+    ring.Publish();
+    CHECK(ring.Reserve() == nullptr);
+    CHECK(ring.Size() == 2);
+}
+
+// Every value arrives exactly once and in order while both sides run at full speed. A side that
+// has to wait yields, so the test also finishes on a single CPU.
+void circleDeqThreads()
+{
+    static CircleDeq<uint32_t, 64> queue;
+    std::thread producer([] {
+        for (uint32_t i = 0; i < kItems;) {
+            if (queue.try_push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    uint32_t value = 0;
+    while (expected < kItems) {
+        if (queue.try_pop(value)) {
+            CHECK(value == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CHECK(queue.empty());
+}
+
+// Same over slots filled and read in place, with a payload that tears if a slot is shared.
+void spscRingThreads()
+{
+    struct Item
+    {
+        uint32_t sequence;
+        uint32_t check;
+    };
+    static SpscRing<Item, 4> ring;
+    std::thread producer([] {
+        for (uint32_t i = 0; i < kItems;) {
+            if (Item* slot = ring.Reserve()) {
+                slot->sequence = i;
+                slot->check = ~i;
+                ring.Publish();
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    while (expected < kItems) {
+        if (const Item* slot = ring.Front()) {
+            CHECK(slot->sequence == expected);
+            CHECK(slot->check == ~expected);
+            ring.Pop();
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    CHECK(ring.Front() == nullptr);
+}
+} // namespace
+
+int main()
+{
+    circleDeqWraps();
+    circleDeqBulk();
+    spscRingInPlace();
+    circleDeqThreads();
+    spscRingThreads();
+    std::printf("ring_test passed\n");
+    return 0;
+}
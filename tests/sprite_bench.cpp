@@ -0,0 +1,142 @@
+#include "RecordingSurface.h"
+#include "bench.h"
+#include "check.h"
+
+#include "hagl/clip.h"
+#include "hagl/rectangle.h"
+#include "hagl/sprite.h"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+// The snake screen: 10 pixel cells, walls around the outside.
+using Surface = RecordingSurface<128, 160>;
+
+constexpr uint32_t kCalls = 1 << 16;
+constexpr int16_t kCell = 10;
+constexpr hagl_color_t kBlack = 0x0000;
+constexpr hagl_color_t kGreen = 0xe007;
+constexpr hagl_color_t kBlue = 0x1f00;
+
+// Display sends the column and row addresses and the memory write command for every window, one
+// command byte and four data bytes each for the addresses. At most that, it skips an address that
+// did not change.
+constexpr uint32_t kWindowBytes = 5 + 5 + 1;
+constexpr double kSpiHz = 62.5e6;
+
+// Same apple as Functions/Snake.cpp.
+constexpr auto appleCanvas = [] {
+    hagl::SpriteCanvas<11, 11> canvas;
+    canvas.fill_rounded_rectangle(0, 0, 10, 10, 4, 1);
+    return canvas;
+}();
+constexpr hagl_color_t applePalette[] = {kBlack, kGreen};
+constexpr auto appleRuns = hagl::sprite_runs<appleCanvas>();
+constexpr hagl_sprite_t appleSprite = hagl::sprite<appleCanvas>(appleRuns, applePalette);
+
+// How the apple was drawn before it became a sprite.
+void drawApple(Surface& surface, int16_t x, int16_t y)
+{
+    hagl_fill_rounded_rectangle_xyxy(surface, x, y, x + kCell, y + kCell, 4, kGreen);
+}
+
+void drawWalls(Surface& surface)
+{
+    for (int16_t i = 0; i < 12; ++i) {
+        hagl_fill_rectangle_xyxy(surface, i * kCell, 0, (i + 1) * kCell, kCell, kBlue);
+        hagl_fill_rectangle_xyxy(surface, i * kCell, 150, (i + 1) * kCell, 160, kBlue);
+    }
+    for (int16_t i = 0; i < 16; ++i) {
+        hagl_fill_rectangle_xyxy(surface, 0, i * kCell, kCell, (i + 1) * kCell, kBlue);
+        hagl_fill_rectangle_xyxy(surface, 120, i * kCell, 130, (i + 1) * kCell, kBlue);
+    }
+}
+
+// The sprite is pixel for pixel what the rounded rectangle drew on an empty cell.
+void matchesDrawing()
+{
+    static Surface drawn;
+    static Surface blitted;
+    drawApple(drawn, 50, 70);
+    hagl_blit_sprite(blitted, 50, 70, &appleSprite);
+    CHECK(blitted.counts().sprites == 1);
+    for (int16_t y = 0; y < Surface::height; ++y) {
+        for (int16_t x = 0; x < Surface::width; ++x) {
+            CHECK(drawn.at(x, y) == blitted.at(x, y));
+        }
+    }
+}
+
+// Clipped to the inside of the walls like Snake does, an apple in a corner cell leaves them alone.
+void keepsOffWalls()
+{
+    static Surface surface;
+    drawWalls(surface);
+    uint32_t wall = surface.count(kBlue);
+    hagl_set_clip(surface, kCell + 1, kCell + 1, 12 * kCell - 1, 15 * kCell - 1);
+    hagl_blit_sprite(surface, kCell, kCell, &appleSprite);
+    hagl_blit_sprite(surface, 10 * kCell, 14 * kCell, &appleSprite);
+    CHECK(surface.count(kBlue) == wall);
+    CHECK(surface.count(kGreen) > 0);
+    CHECK(surface.counts().outside == 0);
+}
+
+struct Cost
+{
+    uint32_t windows;
+    uint32_t pixels;
+};
+
+template <typename Draw>
+Cost cost(Draw&& draw)
+{
+    static Surface surface;
+    surface.reset();
+    draw(surface);
+    const auto& counts = surface.counts();
+    return {counts.sprites + counts.hlines + counts.vlines + counts.pixels, counts.written};
+}
+
+void report(const char* name, Cost cost, double nanos)
+{
+    uint32_t bytes = cost.windows * kWindowBytes + cost.pixels * 2;
+    std::printf("  %-10s %3u windows %4u bytes %6.1f us on the bus %7.1f ns host\n", name,
+        cost.windows, bytes, bytes * 8 / kSpiHz * 1e6, nanos);
+}
+} // namespace
+
+int main()
+{
+    matchesDrawing();
+    keepsOffWalls();
+
+    Cost sprite = cost([](Surface& surface) {
+        hagl_blit_sprite(surface, 50, 70, &appleSprite);
+    });
+    Cost drawing = cost([](Surface& surface) {
+        drawApple(surface, 50, 70);
+    });
+    // The sprite writes every pixel of the cell, the drawing only the green ones.
+    CHECK(sprite.windows == 1);
+    CHECK(sprite.pixels == 11 * 11);
+    CHECK(drawing.windows > sprite.windows);
+
+    static Surface surface;
+    uint32_t sink = 0;
+    double spriteNs = nanosPerCall(kCalls, sink, [](uint32_t i) {
+        hagl_blit_sprite(surface, 10 + i % 100, 70, &appleSprite);
+        return surface.at(50, 75);
+    });
+    double drawingNs = nanosPerCall(kCalls, sink, [](uint32_t i) {
+        drawApple(surface, 10 + i % 100, 70);
+        return surface.at(50, 75);
+    });
+
+    std::printf("Apple cell, per draw (checksum %u)\n", sink);
+    report("sprite", sprite, spriteNs);
+    report("drawing", drawing, drawingNs);
+    std::printf("sprite_bench passed\n");
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include "check.h"
+
+#include "Utils/Comm.h"
+#include "Utils/SpscRing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+using mini_lcd::Message;
+using mini_lcd::SpscRing;
+using Clock = std::chrono::steady_clock;
+
+namespace
+{
+constexpr uint32_t kMessages = 200'000;
+constexpr int kCores = 16;
+
+struct Result
+{
+    double messagesPerSecond;
+    double meanLatencyUs;
+};
+
+uint64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch())
+        .count();
+}
+
+// Measurements of a 16 core server, stamped with the time they were handed over.
+void fill(Message& message, uint32_t sequence)
+{
+    message.type = Message::Type::Measurements;
+    message.data[Message::Cores] = kCores;
+    message.data[Message::GpuVd] = sequence;
+    for (int i = 0; i < kCores / 4; ++i) {
+        message.data[Message::CoreLoads + i] = sequence * 0x01010101u;
+    }
+    uint64_t stamp = now();
+    message.data[Message::Ram] = static_cast<uint32_t>(stamp);
+    message.data[Message::Gpu] = static_cast<uint32_t>(stamp >> 32);
+}
+
+uint64_t received(const Message& message, uint32_t sequence)
+{
+    CHECK(message.type == Message::Type::Measurements);
+    CHECK(message.data[Message::GpuVd] == sequence);
+    CHECK(message.data[Message::CoreLoads + kCores / 4 - 1] == sequence * 0x01010101u);
+    uint64_t stamp =
+        message.data[Message::Ram] | (static_cast<uint64_t>(message.data[Message::Gpu]) << 32);
+    return now() - stamp;
+}
+
+template <typename Produce, typename Consume>
+Result run(Produce&& produce, Consume&& consume)
+{
+    auto start = Clock::now();
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < kMessages; ++i) {
+            produce(i);
+        }
+    });
+    uint64_t latency = 0;
+    for (uint32_t i = 0; i < kMessages; ++i) {
+        latency += consume(i);
+    }
+    producer.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return {kMessages / seconds, latency / 1000.0 / kMessages};
+}
+
+// Current path: the producer builds the message in a shared slot, the consumer reads it in place.
+Result ring()
+{
+    static SpscRing<Message, 4> ring;
+    return run(
+        [](uint32_t sequence) {
+            Message* slot;
+            while (!(slot = ring.Reserve())) {
+                std::this_thread::yield();
+            }
+            fill(*slot, sequence);
+            ring.Publish();
+        },
+        [](uint32_t sequence) {
+            Message* slot;
+            while (!(slot = ring.Front())) {
+                std::this_thread::yield();
+            }
+            uint64_t latency = received(*slot, sequence);
+            ring.Pop();
+            return latency;
+        });
+}
+
+// Previous path: the type and every word in use pushed through the 8 word inter-core FIFO one at
+// a time and copied into a message on the other side.
+Result fifo()
+{
+    static SpscRing<uint32_t, 8> fifo;
+    auto push = [](uint32_t word) {
+        while (!fifo.Write({&word, 1})) {
+            std::this_thread::yield();
+        }
+    };
+    auto pop = [] {
+        uint32_t word;
+        while (!fifo.Read({&word, 1})) {
+            std::this_thread::yield();
+        }
+        return word;
+    };
+    return run(
+        [&](uint32_t sequence) {
+            Message message;
+            fill(message, sequence);
+            push(static_cast<uint32_t>(message.type));
+            for (int i = 0; i < message.Length(); ++i) {
+                push(message.data[i]);
+            }
+        },
+        [&](uint32_t sequence) {
+            Message message;
+            message.type = static_cast<Message::Type>(pop());
+            message.data[Message::Cores] = pop();
+            for (int i = 1; i < message.Length(); ++i) {
+                message.data[i] = pop();
+            }
+            return received(message, sequence);
+        });
+}
+} // namespace
+
+int main()
+{
+    auto before = fifo();
+    auto after = ring();
+    std::printf("%u messages of %d cores between two threads\n", kMessages, kCores);
+    std::printf("  word FIFO:  %6.2f M msgs/s, mean latency %8.2f us\n",
+        before.messagesPerSecond / 1e6, before.meanLatencyUs);
+    std::printf("  SPSC ring:  %6.2f M msgs/s, mean latency %8.2f us\n",
+        after.messagesPerSecond / 1e6, after.meanLatencyUs);
+    return 0;
+}